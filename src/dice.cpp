@@ -12,39 +12,29 @@
 // Counts the number of eyes beating another die, i.e. returns the number of (*this > other) and (other > *this) sides.
 // Probability P(*this > other) = count_beats(other)[0] / (double)(NumSides * NumSides).
 // Probability P(other > *this) = count_beats(other)[1] / (double)(NumSides * NumSides).
+// Both dice are compared by a sorted merge in O(M log M), or in O(M) if both dice are already sorted.
 std::array<size_t, 2> Die::count_beats(const Die& other) const
 {
-    const std::vector<DieValueT>& this_values = values();
-    const std::vector<DieValueT>& other_values = other.values();
-    assert(this_values.size() == other_values.size());
-    std::array<size_t, 2> beat_cnt = { 0, 0 };
-    for (size_t n = 0; n < this_values.size(); n++)
-    {
-        for (size_t m = 0; m < other_values.size(); m++)
-        {
-            if (this_values[n] > other_values[m])
-                beat_cnt[0]++; // this die side beats the others die side
-            else if (other_values[m] > this_values[n])
-                beat_cnt[1]++; // the others die side beats this die side
-        }
-    }
-    return beat_cnt;
+    assert(num_values() == other.num_values());
+    if (values_sorted && other.values_sorted)
+        return DiceUtil::count_beats_sorted(values(), other.values());
+    std::vector<DieValueT> this_values = values();
+    std::vector<DieValueT> other_values = other.values();
+    if (!values_sorted)
+        std::sort(this_values.begin(), this_values.end(), std::less<DieValueT>());
+    if (!other.values_sorted)
+        std::sort(other_values.begin(), other_values.end(), std::less<DieValueT>());
+    return DiceUtil::count_beats_sorted(this_values, other_values);
 }
 
 // Computes and returns the probability of beating another die, i.e. returns P(*this > other).
 double Die::probability_to_beat(Die& other)
 {
-    assert(values().size() == other.values().size());
+    assert(num_values() == other.num_values());
     sort_values();
     other.sort_values();
-    const std::vector<DieValueT>& this_values = values();
-    const std::vector<DieValueT>& other_values = other.values();
-    assert(this_values.size() == other_values.size());
-    size_t beat_cnt = 0;
-    for (size_t n = 0; n < this_values.size(); n++)
-        for (size_t m = 0; m < other_values.size() && this_values[n] > other_values[m]; m++)
-            beat_cnt++; // This die side beats the others die side. Note: values are sorted in ascending order, so we can break at first this_values[n] <= other_values[m], since other_values[m+i] >= other_values[m] for all i > 0
-    return (double)beat_cnt / (double)(this_values.size() * other_values.size());
+    std::array<size_t, 2> beat_cnt = count_beats(other);
+    return (double)beat_cnt[0] / (double)(num_values() * other.num_values());
 }
 
 // Sorts the values of this die in descending order
@@ -52,7 +42,7 @@ void Die::sort_values()
 {
     if (!values_sorted)
     {
-        std::sort(values().begin(), values().end(), std::less<DieValueT>());
+        std::sort(m_values.begin(), m_values.end(), std::less<DieValueT>());
         values_sorted = true;
     }
 }
@@ -72,6 +62,8 @@ void Die::mul_add_values(DieValueT factor, DieValueT offset)
 {
     for (size_t n = 0; n < m_values.size(); n++)
         m_values[n] = factor * m_values[n] + offset;
+    if (factor < 0) // negative factors reverse the order of values
+        values_sorted = false;
 }
 
 // Initializing constructor given the values of two single dice by two vectors
@@ -85,6 +77,40 @@ MultiDie::MultiDie(const std::vector<std::vector<DieValueT>>& die_values)
     init(die_values);
 }
 
+// Counts the number of sums beating another die, i.e. returns the number of (*this > other) and (other > *this) outcomes by a weighted merge of both histograms.
+// Probability P(*this > other) = count_beats(other)[0] / (double)(num_values() * other.num_values()).
+std::array<size_t, 2> MultiDie::count_beats(const Die& other) const
+{
+    const MultiDie* other_multi_die = dynamic_cast<const MultiDie*>(&other);
+    if (other_multi_die)
+        return DiceUtil::count_beats_weighted(m_histogram, other_multi_die->m_histogram);
+    return DiceUtil::count_beats_weighted(m_histogram, DiceUtil::histogram(other.values()));
+}
+
+// Replaces all values v_i by value v_i = factor * v_i + offset in all sides of all single dice
+void MultiDie::mul_add_values(DieValueT factor, DieValueT offset)
+{
+    for (size_t n = 0; n < m_die_values.size(); n++)
+        for (size_t m = 0; m < m_die_values[n].size(); m++)
+            m_die_values[n][m] = factor * m_die_values[n][m] + offset;
+    m_histogram = DiceUtil::sum_histogram(m_die_values);
+    m_sum_values.clear();
+}
+
+// Returns all combinations of dice sums sorted in ascending order. Note: The sums are expanded from the histogram on demand, thread-safe.
+const std::vector<DieValueT>& MultiDie::values(void) const
+{
+    std::lock_guard<std::mutex> lock(m_sum_values_mutex.mutex);
+    if (m_sum_values.size() != m_num_values)
+    {
+        m_sum_values.clear();
+        m_sum_values.reserve(m_num_values);
+        for (size_t n = 0; n < m_histogram.size(); n++)
+            DiceUtil::append(m_sum_values, m_histogram[n].first, m_histogram[n].second);
+    }
+    return m_sum_values;
+}
+
 // Print the values of all single dice of this dice tuple
 std::string MultiDie::print(void) const
 {
@@ -98,14 +124,79 @@ std::string MultiDie::print(void) const
 void MultiDie::init(const std::vector<std::vector<DieValueT>> die_values)
 {
     m_die_values = die_values;
-    DiceUtil::generate_sums_recursively(m_die_values, 0, (DieValueT)0, m_values);
+    m_num_values = 1;
+    for (size_t n = 0; n < m_die_values.size(); n++)
+    {
+        if (m_die_values[n].empty())
+            throw std::invalid_argument("MultiDie: die " + std::to_string(n) + " has no sides");
+        if (m_num_values > DiceUtil::MAX_NUM_VALUES / m_die_values[n].size()) // M^K combinations must not overflow
+            throw std::overflow_error("MultiDie: " + std::to_string(m_die_values.size()) + " dice with " + std::to_string(m_die_values[n].size()) + " sides exceed " + std::to_string(DiceUtil::MAX_NUM_VALUES) + " combinations of dice sums");
+        m_num_values *= m_die_values[n].size();
+    }
+    m_histogram = DiceUtil::sum_histogram(m_die_values);
+    m_sum_values.clear();
 }
 
-// Replaces all values v_ij by value v_ij = factor * v_ij + offset in all dice
+// Replaces all values v_ij by value v_ij = factor * v_ij + offset in all dice. The cached beat matrix and paths are kept, if all comparisons are unchanged.
 template <typename DieType> void DiceSetT<DieType>::mul_add_values(DieValueT factor, DieValueT offset)
 {
     for (size_t n = 0; n < m_dice.size(); n++)
         m_dice[n].mul_add_values(factor, offset);
+    if (factor <= 0 || (offset != 0 && !std::is_same<DieType, Die>::value)) // the sum of K values of a tuple is shifted by K*offset
+        invalidate();
+}
+
+// Inserts a die at index idx. Only the row and column of the new die are counted, if the beat matrix has been computed.
+template <typename DieType> void DiceSetT<DieType>::insert(size_t idx, const DieType& die)
+{
+    assert(idx <= m_dice.size());
+    m_dice.insert(m_dice.begin() + idx, die);
+    if (m_beat_matrix.valid())
+    {
+        m_dice[idx].sort_values();
+        m_beat_matrix.insert(m_dice, idx);
+    }
+    invalidate_paths();
+}
+
+// Inserts multiple dice at once, sorted by their index in the current set. The beat matrix is extended once by the rows and columns of all new dice.
+template <typename DieType> void DiceSetT<DieType>::insert(const std::vector<std::pair<size_t, DieType>>& new_dice)
+{
+    if (new_dice.empty())
+        return;
+    std::vector<DieType> dice;
+    std::vector<size_t> new_indices; // indices of the new dice in the extended set
+    dice.reserve(m_dice.size() + new_dice.size());
+    new_indices.reserve(new_dice.size());
+    for (size_t n = 0, new_die_idx = 0; n <= m_dice.size(); n++)
+    {
+        for (; new_die_idx < new_dice.size() && new_dice[new_die_idx].first == n; new_die_idx++)
+        {
+            new_indices.push_back(dice.size());
+            dice.push_back(new_dice[new_die_idx].second);
+        }
+        if (n < m_dice.size())
+            dice.push_back(std::move(m_dice[n]));
+    }
+    assert(new_indices.size() == new_dice.size()); // new_dice must be sorted by index
+    m_dice.swap(dice);
+    if (m_beat_matrix.valid())
+    {
+        for (size_t n = 0; n < new_indices.size(); n++)
+            m_dice[new_indices[n]].sort_values();
+        m_beat_matrix.insert(m_dice, new_indices);
+    }
+    invalidate_paths();
+}
+
+// Removes the die at index idx and its row and column of the beat matrix
+template <typename DieType> void DiceSetT<DieType>::remove(size_t idx)
+{
+    assert(idx < m_dice.size());
+    m_dice.erase(m_dice.begin() + idx);
+    if (m_beat_matrix.valid())
+        m_beat_matrix.remove(idx);
+    invalidate_paths();
 }
 
 // Returns the minimum of all values of all dice
@@ -127,77 +218,420 @@ template <typename DieType> DieValueT DiceSetT<DieType>::min_die_value(void) con
 // paths[0] = (D0, D1, D2, D3, D0) means: P(D0>D1) > 0.5, P(D1>D2) > 0.5, P(D2>D3) > 0.5, P(D3>D0) > 0.5.
 // paths[1] = (D0, D2, D3, D1, D0) means: P(D0>D2) > 0.5, P(D2>D3) > 0.5, P(D3>D1) > 0.5, P(D1>D0) > 0.5.
 template <typename DieType> const DicePathList& DiceSetT<DieType>::search_intransitive_paths(size_t max_final_paths, size_t max_open_paths)
+{
+    DiceSearchStatus status = SEARCH_COMPLETE;
+    return search_intransitive_paths(DiceSearchLimits(), status, max_final_paths, max_open_paths);
+}
+
+// Anytime search of intransitive paths with a deadline and a memory budget. If a limit is exceeded, the search stops and returns the paths found so far.
+// Such incomplete results are not cached, i.e. the next call searches again.
+template <typename DieType> const DicePathList& DiceSetT<DieType>::search_intransitive_paths(const DiceSearchLimits& limits, DiceSearchStatus& status, size_t max_final_paths, size_t max_open_paths)
 {
     if (!m_intransitive_paths_computed)
     {
-        // Create a NxN-matrix (N = number of dice) with matrix(i,j) = 1, if P(D_i>D_j) > 0.5 and i != j, or 0 otherwise.
-        assert(m_dice.size() >= 2); // at least 2 dice required
-        size_t num_die_values = m_dice[0].num_values();
-        size_t beat_cnt_threash = num_die_values * num_die_values / 2; // i.e. P(D_i>D_j) > 0.5, if beat cnt > beat_cnt_threash
-        size_t lose_cnt_threash = num_die_values * num_die_values / 2; // i.e. P(D_i>D_j) < 0.5, if beat cnt < lose_cnt_threash
-        if (((num_die_values * num_die_values) % 2) != 0)
-            lose_cnt_threash++; // example: 9-sided die => 9*9*0.5 = 40.5 => P(D_i>D_j) > 0.5, if beat cnt > 40, P(D_i>D_j) < 0.5, if beat cnt < 41
-        SqrMatrix<int> beat_matrix(m_dice.size(), 0); // NxN-matrix with matrix(i,j) = 1 if P(D_i>D_j) > 0.5 for all 0<=i,j<N and i!=j, initialized with 0
-        SqrMatrix<int> lose_matrix(m_dice.size(), 0); // NxN-matrix with matrix(i,j) = 1 if P(D_i>D_j) < 0.5 for all 0<=i,j<N and i!=j, initialized with 0
-        for (int i = 0; i < (int)m_dice.size(); i++)
-            for (int j = i + 1; j < (int)m_dice.size(); j++)
+        m_intransitive_paths = DicePathList(m_cycle_deduplication); // list of all transitive paths (which is empty if the dice are not intransitive)
+        // duplicated cycles dropped by m_intransitive_paths do not count as final paths
+        DicePathVisitor visitor([&](const DicePath& path) { m_intransitive_paths.append(path); return m_intransitive_paths.size() < max_final_paths; }, (max_final_paths > 0) ? INT_MAX : 0,
+            limits, [&]() { return m_intransitive_paths.memory_bytes(); });
+        visit_intransitive_paths(visitor, max_open_paths, SIZE_MAX); // the reversed beat cycles take no more memory than the collected paths
+        m_intransitive_paths_status = visitor.status();
+        m_intransitive_paths_computed = (m_intransitive_paths_status != SEARCH_DEADLINE_EXCEEDED && m_intransitive_paths_status != SEARCH_MEMORY_EXCEEDED);
+    }
+    status = m_intransitive_paths_status;
+    return m_intransitive_paths;
+}
+
+// Streams the intransitive paths without collecting them: calls visit(path) for each closed cycle as soon as it is found, beat cycles first,
+// then lose cycles, in the same order as search_intransitive_paths. The search stops, if visit returns false, after max_final_paths, or if
+// a limit is exceeded. Returns the number of visited paths and optionally the status of the search.
+template <typename DieType> size_t DiceSetT<DieType>::visit_intransitive_paths(const std::function<bool(const DicePath& path)>& visit, size_t max_final_paths, size_t max_open_paths,
+    const DiceSearchLimits& limits, DiceSearchStatus* status)
+{
+    DicePathVisitor visitor(visit, max_final_paths, limits);
+    visit_intransitive_paths(visitor, max_open_paths, m_max_streamed_reversed_paths);
+    if (status)
+        *status = visitor.status();
+    return visitor.num_paths();
+}
+
+// Passes the intransitive paths to a visitor, beat cycles first, then lose cycles. If the lose matrix is the transposed beat matrix (e.g. no ties),
+// the matrix is searched only once: the reversed beat cycles are collected during the search and passed as lose cycles in the same order.
+// If there are more than max_reversed_paths beat cycles, the collected cycles are released and the lose matrix is searched.
+template <typename DieType> void DiceSetT<DieType>::visit_intransitive_paths(DicePathVisitor& visitor, size_t max_open_paths, size_t max_reversed_paths)
+{
+    // Create a NxN-matrix (N = number of dice) with matrix(i,j) = 1, if P(D_i>D_j) > 0.5 and i != j, or 0 otherwise.
+    assert(m_dice.size() >= 2); // at least 2 dice required
+    const BeatMatrix& counts = beat_matrix();
+    BitMatrix beat_matrix = counts.create_beat_matrix(); // NxN-matrix with matrix(i,j) = 1 if P(D_i>D_j) > 0.5 for all 0<=i,j<N and i!=j
+    bool lose_is_transposed_beat = counts.lose_is_transposed_beat(); // if true, the lose cycles are the reversed beat cycles in reversed_beat_paths
+    const size_t path_size = m_dice.size() + 1;
+    std::vector<int> reversed_beat_paths; // dice of all lose cycles (N+1 dice per cycle), if the lose matrix is the transposed beat matrix
+    // Search of closed cycles in the matrix, which contain all dice exactly once
+    if (precheck_intransitive_is_possible(beat_matrix)) // Fast pre-check for intransitive chains: in- and out-degrees >= 1 and a single strongly connected component in the beat-matrix, otherwise the dice are not intransitive.
+    {
+        PRINT_DBG_PATH_SEARCH(std::endl << "search_intransitive_paths(" << m_name << "): beat_matrix =" << std::endl << beat_matrix.print() << "search_intransitive_paths(" << m_name << "): pre-check for beat matrix passed" << std::endl);
+        if (lose_is_transposed_beat)
+            visitor.set_observer([&](const DicePath& path)
+                {
+                    if (!lose_is_transposed_beat)
+                        return;
+                    if (reversed_beat_paths.size() / path_size >= max_reversed_paths) // too many beat cycles: release the buffer and search the lose matrix
+                    {
+                        std::vector<int>().swap(reversed_beat_paths);
+                        lose_is_transposed_beat = false;
+                        return;
+                    }
+                    reversed_beat_paths.insert(reversed_beat_paths.end(), std::make_reverse_iterator(path.data() + path.size()), std::make_reverse_iterator(path.data()));
+                },
+                [&]() { return reversed_beat_paths.capacity() * sizeof(int); });
+        search_closed_cycle(beat_matrix, visitor, max_open_paths); // intransitive chains in beat matrix (P(D_i>D_j) > 0.5 for all 0<=i,j<N, i!=j)
+        visitor.set_observer(nullptr);
+        PRINT_DBG_PATH_SEARCH("search_intransitive_paths(" << m_name << "): " << visitor.num_paths() << " final beat paths" << std::endl);
+    }
+    else
+        PRINT_DBG_PATH_SEARCH(std::endl << "search_intransitive_paths(" << m_name << "): beat_matrix =" << std::endl << beat_matrix.print() << "search_intransitive_paths(" << m_name << "): pre-check for beat matrix NOT passed" << std::endl);
+    if (visitor.done())
+        return;
+    if (lose_is_transposed_beat) // each lose cycle is a reversed beat cycle, and the beat matrix has been searched completely
+    {
+        PRINT_DBG_PATH_SEARCH("search_intransitive_paths(" << m_name << "): lose_matrix = transposed beat_matrix, " << reversed_beat_paths.size() / path_size << " reversed beat paths" << std::endl);
+        for (size_t path_idx = 0; path_idx + path_size <= reversed_beat_paths.size() && visitor.within_limits(reversed_beat_paths.capacity() * sizeof(int)); path_idx += path_size)
+        {
+            DicePath path;
+            for (size_t n = 0; n < path_size; n++)
+                path.append(reversed_beat_paths[path_idx + n]);
+            if (!visitor.visit(path))
+                break;
+        }
+        return;
+    }
+    BitMatrix lose_matrix = counts.create_lose_matrix(); // NxN-matrix with matrix(i,j) = 1 if P(D_i>D_j) < 0.5 for all 0<=i,j<N and i!=j
+    if (precheck_intransitive_is_possible(lose_matrix)) // Fast pre-check for intransitive chains: in- and out-degrees >= 1 and a single strongly connected component in the lose-matrix, otherwise the dice are not intransitive.
+    {
+        PRINT_DBG_PATH_SEARCH(std::endl << "search_intransitive_paths(" << m_name << "): lose_matrix =" << std::endl << lose_matrix.print() << "search_intransitive_paths(" << m_name << "): pre-check for lose matrix passed" << std::endl);
+        search_closed_cycle(lose_matrix, visitor, max_open_paths); // intransitive chains in lose matrix (P(D_i>D_j) < 0.5 for all 0<=i,j<N, i!=j)
+        PRINT_DBG_PATH_SEARCH("search_intransitive_paths(" << m_name << "): " << visitor.num_paths() << " final beat and lose paths" << std::endl);
+    }
+    else
+        PRINT_DBG_PATH_SEARCH(std::endl << "search_intransitive_paths(" << m_name << "): lose_matrix =" << std::endl << lose_matrix.print() << "search_intransitive_paths(" << m_name << "): pre-check for lose matrix NOT passed" << std::endl);
+}
+
+// Visits one intransitive path of each orbit under the symmetries of the beat resp. lose matrix, beat cycles first, then lose cycles.
+// Returns the number of visited orbits and optionally the status of the search.
+template <typename DieType> size_t DiceSetT<DieType>::visit_intransitive_path_orbits(const std::function<bool(const DicePath& path, size_t orbit_size)>& visit,
+    const DiceSearchLimits& limits, DiceSearchStatus* status)
+{
+    assert(m_dice.size() >= 2); // at least 2 dice required
+    const BeatMatrix& counts = beat_matrix();
+    BitMatrix matrices[2] = { counts.create_beat_matrix(), counts.create_lose_matrix() };
+    size_t orbit_size = 1;
+    DicePathVisitor visitor([&](const DicePath& path) { return visit(path, orbit_size); }, INT_MAX, limits);
+    for (int matrix_idx = 0; matrix_idx < 2 && !visitor.done(); matrix_idx++)
+    {
+        if (!precheck_intransitive_is_possible(matrices[matrix_idx]))
+            continue;
+        DiceGraph::CycleSymmetry symmetry(matrices[matrix_idx]);
+        if (!symmetry.has_symmetry()) // each path is an orbit of its own
+        {
+            orbit_size = 1;
+            search_closed_cycle_backtracking(matrices[matrix_idx], visitor);
+            continue;
+        }
+        search_canonical_cycles(matrices[matrix_idx], symmetry, [&](const std::vector<int>& cycle)
+            {
+                orbit_size = symmetry.orbit_size(cycle);
+                return visitor.visit(DicePath(cycle));
+            },
+            [&]() { return !visitor.within_limits(); });
+    }
+    if (status)
+        *status = visitor.status();
+    return visitor.num_paths();
+}
+
+// Returns all intransitive paths in the orbit of a path (D_0, ..., D_0) under the symmetries of the beat resp. lose matrix, which contains the path.
+// Returns the path itself, if the matrix has no symmetries or the path does not start at D_0.
+template <typename DieType> std::vector<DicePath> DiceSetT<DieType>::expand_path_orbit(const DicePath& path)
+{
+    const int N = (int)m_dice.size();
+    if (path.size() != (size_t)N + 1 || path.at(0) != 0 || path.at(N) != 0 || N < 3)
+        return std::vector<DicePath>(1, path);
+    const BeatMatrix& counts = beat_matrix();
+    BitMatrix matrix = (probability_to_beat(path.at(0), path.at(1)) > 0.5) ? counts.create_beat_matrix() : counts.create_lose_matrix();
+    DiceGraph::CycleSymmetry symmetry(matrix);
+    std::vector<int> cycle(path.size());
+    for (size_t n = 0; n < path.size(); n++)
+        cycle[n] = path.at(n);
+    std::vector<std::vector<int>> orbit = symmetry.orbit(cycle);
+    std::vector<DicePath> paths;
+    for (size_t orbit_idx = 0; orbit_idx < orbit.size(); orbit_idx++)
+        paths.push_back(DicePath(orbit[orbit_idx]));
+    return paths;
+}
+
+// Returns true, if this set of dice is intransitive, i.e. there is at least one intransitive path.
+template <typename DieType> bool DiceSetT<DieType>::has_intransitive_paths()
+{
+    if (m_intransitive_paths_computed)
+        return m_intransitive_paths.size() > 0;
+    DicePath path;
+    return find_intransitive_path(path);
+}
+
+// Finds a single intransitive path. If no pair of dice ties, the beat and lose matrices are tournaments, and a path is constructed in O(N*N).
+// Otherwise the first path found by search_closed_cycle is returned, or a verified path found by the rotation-extension heuristic for large sets.
+// Returns false, if the dice are not intransitive.
+template <typename DieType> bool DiceSetT<DieType>::find_intransitive_path(DicePath& path)
+{
+    assert(m_dice.size() >= 2); // at least 2 dice required
+    path = DicePath();
+    if (m_intransitive_paths_computed)
+    {
+        if (m_intransitive_paths.size() == 0)
+            return false;
+        path = m_intransitive_paths.front();
+        return true;
+    }
+    const BeatMatrix& counts = beat_matrix();
+    const BitMatrix matrices[2] = { counts.create_beat_matrix(), counts.create_lose_matrix() };
+    if (m_first_path_strategy == FirstPathStrategy::ROTATION_EXTENSION && m_dice.size() >= m_rotation_extension_min_dice) // Large sets: try the heuristic on both matrices before the exact search
+    {
+        for (int matrix_idx = 0; matrix_idx < 2; matrix_idx++)
+        {
+            std::vector<int> cycle;
+            if (!DiceGraph::is_tournament(matrices[matrix_idx]) && precheck_intransitive_is_possible(matrices[matrix_idx])
+                && DiceGraph::find_hamiltonian_cycle_by_rotation_extension(matrices[matrix_idx], cycle, m_rotation_extension_restarts, m_rotation_extension_threads)
+                && DiceGraph::is_hamiltonian_cycle(matrices[matrix_idx], cycle))
             {
-                assert(num_die_values == m_dice[i].num_values() && num_die_values == m_dice[j].num_values());
-                std::array<size_t, 2> beats = m_dice[i].count_beats(m_dice[j]);
-                if (beats[0] > beat_cnt_threash) // i.e. P(D_i>D_j) > 0.5
-                    beat_matrix.at(i, j) = 1;
-                if (beats[0] < lose_cnt_threash) // i.e. P(D_i>D_j) < 0.5
-                    lose_matrix.at(i, j) = 1;
-                if (beats[1] > beat_cnt_threash) // i.e. P(D_j>D_i) > 0.5
-                    beat_matrix.at(j, i) = 1;
-                if (beats[1] < lose_cnt_threash) // i.e. P(D_j>D_i) > 0.5
-                    lose_matrix.at(j, i) = 1;
+                path = DicePath(cycle);
+                return true;
             }
-        // Recursive search of closed cycles in the matrix, which contain all dice exactly once
-        DicePathList final_beat_paths, final_lose_paths;
-        if (precheck_intransitive_is_possible(beat_matrix)) // Fast pre-check for intransitive chains: All columns of a beat-matrix must have at least one "1", otherwise the dice are not intransitive.
+        }
+    }
+    for (int matrix_idx = 0; matrix_idx < 2; matrix_idx++)
+    {
+        if (DiceGraph::is_tournament(matrices[matrix_idx])) // Fast path without ties: construct a cycle, if the tournament is strongly connected
         {
-            PRINT_DBG_PATH_SEARCH(std::endl << "search_intransitive_paths(" << m_name << "): beat_matrix =" << std::endl << beat_matrix.print() << "search_intransitive_paths(" << m_name << "): pre-check for beat matrix passed" << std::endl);
-            final_beat_paths = search_closed_cycle(beat_matrix, max_final_paths, max_open_paths); // intransitive chains in beat matrix (P(D_i>D_j) > 0.5 for all 0<=i,j<N, i!=j)
-            PRINT_DBG_PATH_SEARCH("search_intransitive_paths(" << m_name << "): final beat paths = " << final_beat_paths.print() << std::endl);
+            std::vector<int> cycle;
+            if (DiceGraph::find_hamiltonian_cycle_in_tournament(matrices[matrix_idx], cycle))
+            {
+                path = DicePath(cycle);
+                return true;
+            }
         }
-        else
-            PRINT_DBG_PATH_SEARCH(std::endl << "search_intransitive_paths(" << m_name << "): beat_matrix =" << std::endl << beat_matrix.print() << "search_intransitive_paths(" << m_name << "): pre-check for beat matrix NOT passed" << std::endl);
-        if (final_beat_paths.size() < max_final_paths)
+        else if (precheck_intransitive_is_possible(matrices[matrix_idx])) // Ties: fall back to the search of the first cycle
+        {
+            DicePathList paths = search_closed_cycle(matrices[matrix_idx], 1, INT_MAX);
+            if (paths.size() > 0)
+            {
+                path = paths.front();
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Counts the intransitive paths exactly without enumerating them, i.e. returns the number of paths found by search_intransitive_paths(INT_MAX).
+// Closed cycles in the beat and lose matrix are counted by a subset dynamic programming (Held-Karp) in O(2^N*N*N) time for up to about 25 dice.
+template <typename DieType> bool DiceSetT<DieType>::count_intransitive_paths(uint64_t& num_paths, DicePath* witness, size_t max_memory_bytes)
+{
+    assert(m_dice.size() >= 2); // at least 2 dice required
+    num_paths = 0;
+    if (witness)
+        *witness = DicePath();
+    const BeatMatrix& counts = beat_matrix();
+    const BitMatrix matrices[2] = { counts.create_beat_matrix(), counts.create_lose_matrix() };
+    std::mt19937 random_generator(0);
+    for (int matrix_idx = 0; matrix_idx < 2; matrix_idx++)
+    {
+        if (!precheck_intransitive_is_possible(matrices[matrix_idx]))
+            continue;
+        if (matrix_idx == 1 && counts.lose_is_transposed_beat()) // each lose cycle is a reversed beat cycle
+        {
+            if (num_paths + num_paths < num_paths)
+                return false;
+            num_paths += num_paths;
+            continue;
+        }
+        uint64_t num_cycles = 0;
+        std::vector<int> cycle;
+        bool sample_witness = (witness != 0 && num_paths == 0);
+        if (!DiceGraph::count_hamiltonian_cycles(matrices[matrix_idx], num_cycles, sample_witness ? &cycle : 0, random_generator, max_memory_bytes) || num_paths + num_cycles < num_paths)
+            return false;
+        num_paths += num_cycles;
+        if (sample_witness && num_cycles > 0)
         {
-            if (precheck_intransitive_is_possible(lose_matrix)) // Fast pre-check for intransitive chains: All columns of a lose-matrix must have at least one "1", otherwise the dice are not intransitive.
+            if (cycle.empty()) // not all layers of the dynamic programming fit into memory: take the first cycle found by backtracking
             {
-                PRINT_DBG_PATH_SEARCH(std::endl << "search_intransitive_paths(" << m_name << "): lose_matrix =" << std::endl << lose_matrix.print() << "search_intransitive_paths(" << m_name << "): pre-check for lose matrix passed" << std::endl);
-                final_lose_paths = search_closed_cycle(lose_matrix, max_final_paths - final_beat_paths.size(), max_open_paths); // intransitive chains in lose matrix (P(D_i>D_j) < 0.5 for all 0<=i,j<N, i!=j)
-                PRINT_DBG_PATH_SEARCH("search_intransitive_paths(" << m_name << "): final lose paths = " << final_lose_paths.print() << std::endl);
+                DicePathVisitor visitor([&](const DicePath& path) { *witness = path; return false; }, 1);
+                search_closed_cycle_backtracking(matrices[matrix_idx], visitor);
             }
             else
-                PRINT_DBG_PATH_SEARCH(std::endl << "search_intransitive_paths(" << m_name << "): lose_matrix =" << std::endl << lose_matrix.print() << "search_intransitive_paths(" << m_name << "): pre-check for lose matrix NOT passed" << std::endl);
+                *witness = DicePath(cycle);
         }
-        m_intransitive_paths = DicePathList(); // list of all transitive paths (which is empty if the dice are not intransitive)
-        m_intransitive_paths.splice(final_beat_paths);
-        m_intransitive_paths.splice(final_lose_paths);
-        m_intransitive_paths_computed = true;
     }
-    return m_intransitive_paths;
+    return true;
 }
 
-// Returns true, if this set of dice is intransitive, i.e. there is at least one intransitive path.
-template <typename DieType> bool DiceSetT<DieType>::has_intransitive_paths()
+// Visits all simple intransitive cycles through min_length to max_length dice, i.e. also cycles through a subset of the dice.
+// Beat cycles are visited first, then lose cycles, each starting at its smallest die. Returns the number of visited cycles.
+template <typename DieType> size_t DiceSetT<DieType>::visit_simple_intransitive_cycles(const std::function<bool(const DicePath& path)>& visit, size_t min_length, size_t max_length, size_t num_threads)
 {
-    if (!m_intransitive_paths_computed)
-        search_intransitive_paths();
-    return m_intransitive_paths.size() > 0;
+    assert(m_dice.size() >= 2); // at least 2 dice required
+    const BeatMatrix& counts = beat_matrix();
+    const BitMatrix matrices[2] = { counts.create_beat_matrix(), counts.create_lose_matrix() };
+    size_t num_cycles = 0;
+    for (int matrix_idx = 0; matrix_idx < 2; matrix_idx++)
+    {
+        bool continue_search = DiceGraph::enumerate_simple_cycles(matrices[matrix_idx], min_length, max_length, [&](const std::vector<int>& cycle)
+            {
+                num_cycles++;
+                return visit(DicePath(cycle));
+            }, num_threads);
+        if (!continue_search)
+            break;
+    }
+    return num_cycles;
+}
+
+// Finds a longest intransitive cycle, i.e. an intransitive path through all dice by find_intransitive_path if possible,
+// or otherwise the longest simple cycle through a subset of the dice in the beat or lose matrix.
+template <typename DieType> bool DiceSetT<DieType>::find_longest_intransitive_cycle(DicePath& path, size_t num_threads)
+{
+    if (find_intransitive_path(path))
+        return true;
+    const BeatMatrix& counts = beat_matrix();
+    const BitMatrix matrices[2] = { counts.create_beat_matrix(), counts.create_lose_matrix() };
+    std::vector<int> longest_cycle;
+    for (int matrix_idx = 0; matrix_idx < 2; matrix_idx++)
+    {
+        std::vector<int> cycle;
+        if (DiceGraph::find_longest_simple_cycle(matrices[matrix_idx], cycle, num_threads) && cycle.size() > longest_cycle.size())
+            longest_cycle.swap(cycle);
+    }
+    path = DicePath(longest_cycle);
+    return !longest_cycle.empty();
+}
+
+// Finds the most robust intransitive path, i.e. the closed cycle through all dice with the largest bottleneck probability. The probabilities
+// of all edges in the beat and lose matrix are ranked into levels (identical counts give identical levels), then the beat matrix and the lose matrix
+// are searched by branch and bound. The lose matrix only needs to be searched for a cycle with a larger bottleneck than the best beat cycle.
+template <typename DieType> bool DiceSetT<DieType>::find_most_robust_intransitive_path(DicePath& path, double& bottleneck_probability)
+{
+    assert(m_dice.size() >= 2); // at least 2 dice required
+    const BeatMatrix& counts = beat_matrix();
+    const int N = (int)m_dice.size();
+    const BitMatrix matrices[2] = { counts.create_beat_matrix(), counts.create_lose_matrix() };
+    SqrMatrix<double> edge_probabilities(N, 0.0); // P(D_i>D_j) for beat edges, 1-P(D_i>D_j) for lose edges
+    std::vector<double> levels; // all edge probabilities in ascending order
+    for (int i = 0; i < N; i++)
+    {
+        for (int j = 0; j < N; j++)
+        {
+            if (matrices[0].at(i, j))
+                edge_probabilities.at(i, j) = counts.probability(i, j);
+            else if (matrices[1].at(i, j))
+                edge_probabilities.at(i, j) = (double)(counts.num_outcomes(i, j) - counts.wins(i, j)) / (double)counts.num_outcomes(i, j);
+            if (matrices[0].at(i, j) || matrices[1].at(i, j))
+                levels.push_back(edge_probabilities.at(i, j));
+        }
+    }
+    std::sort(levels.begin(), levels.end());
+    levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+    path = DicePath();
+    int best_level = -1;
+    for (int matrix_idx = 0; matrix_idx < 2; matrix_idx++)
+    {
+        if (!precheck_intransitive_is_possible(matrices[matrix_idx]))
+            continue;
+        SqrMatrix<int> edge_levels(N, -1);
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < N; j++)
+                if (matrices[matrix_idx].at(i, j))
+                    edge_levels.at(i, j) = (int)(std::lower_bound(levels.begin(), levels.end(), edge_probabilities.at(i, j)) - levels.begin());
+        std::vector<int> cycle;
+        int bottleneck_level = -1;
+        if (DiceGraph::find_bottleneck_hamiltonian_cycle(edge_levels, best_level, cycle, bottleneck_level))
+        {
+            path = DicePath(cycle);
+            best_level = bottleneck_level;
+        }
+    }
+    bottleneck_probability = (best_level >= 0) ? levels[best_level] : 0.0;
+    return best_level >= 0;
+}
+
+// Returns the exact win and loss counts of all pairs of dice. The matrix is computed once in parallel on first use and
+// reused by all queries and prints, until the dice are changed by mul_add_values or set().
+template <typename DieType> const BeatMatrix& DiceSetT<DieType>::beat_matrix(void)
+{
+    if (!m_beat_matrix.valid())
+    {
+        for (size_t n = 0; n < m_dice.size(); n++)
+            m_dice[n].sort_values(); // sort all dice once, so that count_beats can merge the sorted values of each pair
+        m_beat_matrix.compute(m_dice);
+    }
+    return m_beat_matrix;
+}
+
+// Returns the transitive closure of the beat relation (beat = true) resp. the lose relation (beat = false), computed once on the cached beat matrix.
+template <typename DieType> const DiceGraph::ReachabilityIndex& DiceSetT<DieType>::reachability(bool beat)
+{
+    if (!m_reachability_computed)
+    {
+        const BeatMatrix& counts = beat_matrix();
+        m_reachability[0] = DiceGraph::ReachabilityIndex(counts.create_beat_matrix());
+        m_reachability[1] = DiceGraph::ReachabilityIndex(counts.create_lose_matrix());
+        m_reachability_computed = true;
+    }
+    return m_reachability[beat ? 0 : 1];
+}
+
+// Returns the indices of all dice, which are part of an intransitive cycle of the beat or lose relation, i.e. which are in a strongly connected
+// component of at least two dice. Does not require the search of intransitive paths.
+template <typename DieType> std::vector<int> DiceSetT<DieType>::dice_on_intransitive_cycles(void)
+{
+    std::vector<int> dice_indices;
+    for (int n = 0; n < (int)m_dice.size(); n++)
+        if (reachability(true).on_cycle(n) || reachability(false).on_cycle(n))
+            dice_indices.push_back(n);
+    return dice_indices;
+}
+
+// Returns P(D_i>D_j). Uses the cached beat matrix if available, otherwise only the given pair is counted,
+// such that printing a path of a large set of dice does not require the beat matrix of all N*N pairs.
+template <typename DieType> double DiceSetT<DieType>::probability_to_beat(int i, int j)
+{
+    if (m_beat_matrix.valid())
+        return m_beat_matrix.probability(i, j);
+    return m_dice[i].probability_to_beat(m_dice[j]);
+}
+
+// Invalidates the cached beat matrix and intransitive paths after the dice have been changed
+template <typename DieType> void DiceSetT<DieType>::invalidate(void)
+{
+    m_beat_matrix.clear();
+    invalidate_paths();
+}
+
+// Invalidates the cached intransitive paths and reachability, but keeps the beat matrix
+template <typename DieType> void DiceSetT<DieType>::invalidate_paths(void)
+{
+    m_reachability_computed = false;
+    m_intransitive_paths = DicePathList();
+    m_intransitive_paths_computed = false;
 }
 
 // Prints the matrix of beat probabilities P(D_i>D_j) for all i, j.
 template <typename DieType> std::string DiceSetT<DieType>::print_probability_matrix()
 {
+    const BeatMatrix& counts = beat_matrix();
     std::stringstream str;
     for (size_t i = 0; i < m_dice.size(); i++)
     {
         for (size_t j = 0; j < m_dice.size(); j++)
-            str << " " << std::fixed << std::setprecision(3) << m_dice[i].probability_to_beat(m_dice[j]);
+            str << " " << std::fixed << std::setprecision(3) << counts.probability((int)i, (int)j);
         str << std::endl;
     }
     return str.str();
@@ -212,7 +646,7 @@ template <typename DieType> std::string DiceSetT<DieType>::print_path_probabilit
     {
         int dice_from = path.at(dice_cnt - 1);
         int dice_to = path.at(dice_cnt);
-        double probability_to_beat = m_dice[dice_from].probability_to_beat(m_dice[dice_to]);
+        double probability_to_beat = this->probability_to_beat(dice_from, dice_to);
         assert(probability_to_beat >= 0.0 && probability_to_beat <= 1.0);
         if (probability_to_beat > 0.5)
             probability_flag_sum += 1;
@@ -260,7 +694,7 @@ template <typename DieType> std::string DiceSetT<DieType>::print_intransitive_pa
     {
         int dice_from = path.at(dice_cnt - 1);
         int dice_to = path.at(dice_cnt);
-        double probability_to_beat = m_dice[dice_from].probability_to_beat(m_dice[dice_to]);
+        double probability_to_beat = this->probability_to_beat(dice_from, dice_to);
         if (probability_to_beat > 0.5)
             probability_flag_sum += 1;
         else if (probability_to_beat < 0.5)
@@ -285,43 +719,50 @@ template <typename DieType> std::string DiceSetT<DieType>::print_dice(void) cons
 }
 
 // Searches and returns a list of closed cycles (i.e. an intransitive chain of dice), which contain all dice exactly once.
-template <typename DieType> DicePathList DiceSetT<DieType>::search_closed_cycle(const SqrMatrix<int>& matrix, size_t max_final_paths, size_t max_open_paths)
+template <typename DieType> DicePathList DiceSetT<DieType>::search_closed_cycle(const BitMatrix& matrix, size_t max_final_paths, size_t max_open_paths)
 {
-    DicePathList open_path_list, closed_path_list;
+    DicePathList closed_path_list;
+    DicePathVisitor visitor([&](const DicePath& path) { closed_path_list.append(path); return true; }, max_final_paths);
+    search_closed_cycle(matrix, visitor, max_open_paths);
+    // closed_path_list.remove_duplicate_paths(); // test and debugging only (list should not have duplicates)
+    PRINT_DBG_PATH_SEARCH("search_closed_cycle(" << m_name << "): final closed_path_list = " << closed_path_list.print() << std::endl);
+    return closed_path_list;
+}
+
+// Searches closed cycles, which contain all dice exactly once, and passes each cycle to the visitor as soon as it is found.
+template <typename DieType> void DiceSetT<DieType>::search_closed_cycle(const BitMatrix& matrix, DicePathVisitor& visitor, size_t max_open_paths)
+{
+    if (visitor.done())
+        return;
+    if (m_cycle_search_strategy == CycleSearchStrategy::BACKTRACKING)
+        return search_closed_cycle_backtracking(matrix, visitor);
+    if (m_cycle_search_strategy == CycleSearchStrategy::PARALLEL_BACKTRACKING)
+        return search_closed_cycle_parallel(matrix, visitor, m_num_search_threads, m_stable_path_order);
+    if (m_cycle_search_strategy == CycleSearchStrategy::SYMMETRIC_BACKTRACKING)
+        return search_closed_cycle_symmetric(matrix, visitor);
+    DiceOpenPathList open_path_list;
     std::vector<std::vector<int>> col_indices_per_row = matrix.create_col_indices_foreach_row();
     PRINT_DBG_PATH_SEARCH("search_closed_cycle(" << m_name << "): col_indices_per_row = " << std::endl << DiceUtil::print(col_indices_per_row));
     const std::vector<int>& candidates = col_indices_per_row[0]; // successors of the first die D_0 with P(D_i > D_n) > 0.5, a cycle starts here
     for (size_t n = 0; n < candidates.size(); n++)
         open_path_list.append(DicePath({ 0, candidates[n] }));
-    for (size_t n = 0; n < candidates.size() && closed_path_list.size() < max_final_paths; n++)
-        search_closed_cycle_recursive(col_indices_per_row, open_path_list, closed_path_list, candidates[n], max_final_paths, max_open_paths);
-    // closed_path_list.remove_duplicate_paths(); // test and debugging only (list should not have duplicates)
-    PRINT_DBG_PATH_SEARCH("search_closed_cycle(" << m_name << "): final closed_path_list = " << closed_path_list.print() << std::endl);
-    return closed_path_list;
+    for (size_t n = 0; n < candidates.size() && !visitor.done(); n++)
+        search_closed_cycle_recursive(col_indices_per_row, open_path_list, visitor, candidates[n], max_open_paths);
 }
 
 // Recursive search of a closed cycle, which contains all dice exactly once.
-template <typename DieType> void DiceSetT<DieType>::search_closed_cycle_recursive(const std::vector<std::vector<int>>& col_indices_per_row, DicePathList& open_path_list, DicePathList& closed_path_list, int row_idx, size_t max_final_paths, size_t max_open_paths)
+template <typename DieType> void DiceSetT<DieType>::search_closed_cycle_recursive(const std::vector<std::vector<int>>& col_indices_per_row, DiceOpenPathList& open_path_list, DicePathVisitor& visitor, int row_idx, size_t max_open_paths)
 {
     PRINT_DBG_PATH_SEARCH("search_closed_cycle_recursive(row_idx=" << row_idx << "): input open_path_list = " << open_path_list.print() << std::endl);
-    PRINT_DBG_PATH_SEARCH("search_closed_cycle_recursive(row_idx=" << row_idx << "): input closed_path_list = " << closed_path_list.print() << std::endl);
+    PRINT_DBG_PATH_SEARCH("search_closed_cycle_recursive(row_idx=" << row_idx << "): input " << visitor.num_paths() << " closed paths" << std::endl);
+    if (!visitor.within_limits(open_path_list.memory_bytes())) // deadline or memory budget exceeded
+        return;
     std::vector<int> candidates = col_indices_per_row[row_idx]; // all successors of the die D_i with P(D_i > D_n) > 0.5
     PRINT_DBG_PATH_SEARCH("search_closed_cycle_recursive(row_idx=" << row_idx << "): candidates = " << DiceUtil::print(candidates) << std::endl);
     std::vector<int> dice_indices_to_investigate;
     dice_indices_to_investigate.reserve(candidates.size());
     // Sort candidates by row_idx successors to increase the chance for a cycle, such that candidates[0] > row_idx, candidates[1] >  candidates[0], ...<wrap-around>..., candidates[i] < row_idx after sort
-    std::sort(candidates.begin(), candidates.end(), std::less<int>());
-    if (candidates.size() > 1 && row_idx < candidates.back())
-    {
-        std::vector<int> candidates_sorted;
-        candidates_sorted.reserve(candidates.size());
-        std::vector<int>::iterator candidates_sorted_start = candidates.begin();
-        while (*candidates_sorted_start < row_idx)
-            candidates_sorted_start++;
-        std::copy(candidates_sorted_start, candidates.end(), std::back_inserter(candidates_sorted));
-        std::copy(candidates.begin(), candidates_sorted_start, std::back_inserter(candidates_sorted));
-        candidates = candidates_sorted;
-    }
+    sort_candidates_by_successors(candidates, row_idx);
     // We search (and possibly extend) all open paths, which end in dice D_<row_idx>. To speed up iteration over open_path_list to get those paths with back() == row_idx, 
     // we create a list of pointer to the paths with open_path_list[i].back() == row_idx
     std::vector<DicePath*> open_path_list_back_is_row_idx;
@@ -330,7 +771,7 @@ template <typename DieType> void DiceSetT<DieType>::search_closed_cycle_recursiv
         if (path_iter->back() == row_idx)
             open_path_list_back_is_row_idx.push_back(&(*path_iter));
     // Append die candidates to the list of open paths and continue search on all non-cyclic paths
-    for (size_t n = 0; n < candidates.size() && closed_path_list.size() < max_final_paths; n++)
+    for (size_t n = 0; n < candidates.size() && !visitor.done(); n++)
     {
         std::vector<DicePath> paths_to_duplicate; // For each path with last die D_<row_idx>, we duplicate this path after appending a new die, such that all paths ending with D_<row_idx> can be extended with all candidates
         int die_idx = candidates[n]; // Die D_<die_idx> is a successor of die D_<row_idx> => Append D_<die_idx> to all paths ending with D_<row_idx>
@@ -338,7 +779,7 @@ template <typename DieType> void DiceSetT<DieType>::search_closed_cycle_recursiv
         {
             // Append <die_idx> to all paths ending at <row_idx>, but do not further investigate, since the path is a (possibly incomplete) cycle
             PRINT_DBG_PATH_SEARCH("search_closed_cycle_recursive(row_idx=" << row_idx << "): Cycle found, appending " << row_idx << " -> " << die_idx << std::endl);
-            for (int open_path_idx = 0; open_path_idx < open_path_list_back_is_row_idx.size() && closed_path_list.size() < max_final_paths; open_path_idx++)
+            for (int open_path_idx = 0; open_path_idx < open_path_list_back_is_row_idx.size() && !visitor.done(); open_path_idx++)
             {
                 DicePath* path_iter = open_path_list_back_is_row_idx[open_path_idx];
                 assert(path_iter == 0 || path_iter->back() == row_idx);
@@ -348,7 +789,7 @@ template <typename DieType> void DiceSetT<DieType>::search_closed_cycle_recursiv
                     DicePath success_path = *path_iter;
                     success_path.append(die_idx);
                     if (success_path.contains_all_dices(col_indices_per_row.size())) // otherwise it's a partial cycle, which we are not interested in
-                        closed_path_list.append(success_path);
+                        visitor.visit(success_path);
                 }
             }
         }
@@ -387,29 +828,244 @@ template <typename DieType> void DiceSetT<DieType>::search_closed_cycle_recursiv
     open_path_list.remove_paths_by_back_idx(row_idx);
     // open_path_list.remove_duplicate_paths(); // test and debugging only (list should not have duplicates)
     PRINT_DBG_PATH_SEARCH("search_closed_cycle_recursive(row_idx=" << row_idx << "): output open_path_list = " << open_path_list.print() << std::endl);
-    PRINT_DBG_PATH_SEARCH("search_closed_cycle_recursive(row_idx=" << row_idx << "): output closed_path_list = " << closed_path_list.print() << std::endl);
+    PRINT_DBG_PATH_SEARCH("search_closed_cycle_recursive(row_idx=" << row_idx << "): output " << visitor.num_paths() << " closed paths" << std::endl);
     // Continue search recursively
     open_path_list.sort_by_path_length(); // Sort open_path_list by descending path length, such that long paths (with a higher chance to complete) are prefered
-    for (size_t n = 0; n < dice_indices_to_investigate.size() && open_path_list.size() < max_open_paths && closed_path_list.size() < max_final_paths; n++)
+    size_t investigate_cnt = 0;
+    for (; investigate_cnt < dice_indices_to_investigate.size() && open_path_list.size() < max_open_paths && !visitor.done(); investigate_cnt++)
     {
-        search_closed_cycle_recursive(col_indices_per_row, open_path_list, closed_path_list, dice_indices_to_investigate[n], max_final_paths, max_open_paths);
+        search_closed_cycle_recursive(col_indices_per_row, open_path_list, visitor, dice_indices_to_investigate[investigate_cnt], max_open_paths);
     }
+    if (investigate_cnt < dice_indices_to_investigate.size() && open_path_list.size() >= max_open_paths)
+        visitor.skipped_open_paths();
 }
 
-// Fast pre-check for intransitive chains: All columns of a beat/lose-matrix must have at least one "1", otherwise the dice are not intransitive.
-template <typename DieType> bool DiceSetT<DieType>::precheck_intransitive_is_possible(const SqrMatrix<int>& matrix)
+// Depth-first backtracking search of closed cycles, which contain all dice exactly once. A single path is extended in place
+// and visited dice are marked in a bitmask, i.e. memory is O(N) independent of the number of partial paths.
+template <typename DieType> void DiceSetT<DieType>::search_closed_cycle_backtracking(const BitMatrix& matrix, DicePathVisitor& visitor)
 {
-    for (int i = 0; i < (int)matrix.size(); i++)
+    if (visitor.done())
+        return;
+    std::vector<std::vector<int>> candidates_per_row = create_sorted_candidates(matrix);
+    search_closed_cycle_from_prefix(matrix, candidates_per_row, { 0 }, [&](const std::vector<int>& cycle)
+        {
+            DicePath path(cycle);
+            PRINT_DBG_PATH_SEARCH("search_closed_cycle_backtracking(" << m_name << "): cycle found " << path.print() << std::endl);
+            return visitor.visit(path);
+        },
+        [&]() { return !visitor.within_limits(); });
+}
+
+// Parallel depth-first backtracking search of closed cycles, which contain all dice exactly once. The search tree is split into tasks
+// by path prefixes of 1 to 3 successors of D_0, which run on a work-stealing thread pool. The visitor is called by one thread at a time,
+// and the search stops as soon as the visitor is done. If stable_path_order is true, the paths are visited in the same order as by
+// search_closed_cycle_backtracking: each task collects its paths, which are passed to the visitor in task order as soon as all
+// previous tasks are finished, and a task is cancelled, if the visitor is done before it. Otherwise the paths are visited in order of completion.
+template <typename DieType> void DiceSetT<DieType>::search_closed_cycle_parallel(const BitMatrix& matrix, DicePathVisitor& visitor, size_t num_threads, bool stable_path_order)
+{
+    const int N = (int)matrix.size();
+    if (visitor.done())
+        return;
+    DiceThreadPool thread_pool(num_threads);
+    std::vector<std::vector<int>> candidates_per_row = create_sorted_candidates(matrix);
+    // Split the search tree into tasks: expand the path prefixes (in the same order as the sequential search) until there are enough tasks for all threads
+    std::vector<std::vector<int>> prefixes = { { 0 } };
+    for (int depth = 1; depth <= 3 && depth < N - 1 && prefixes.size() < 4 * thread_pool.num_threads(); depth++)
+    {
+        std::vector<std::vector<int>> next_prefixes;
+        for (size_t n = 0; n < prefixes.size(); n++)
+        {
+            const std::vector<int>& candidates = candidates_per_row[prefixes[n].back()];
+            for (size_t m = 0; m < candidates.size(); m++)
+            {
+                if (std::find(prefixes[n].begin(), prefixes[n].end(), candidates[m]) == prefixes[n].end())
+                {
+                    next_prefixes.push_back(prefixes[n]);
+                    next_prefixes.back().push_back(candidates[m]);
+                }
+            }
+        }
+        prefixes.swap(next_prefixes);
+    }
+    const size_t num_tasks = prefixes.size();
+    const size_t max_task_paths = visitor.max_paths() - visitor.num_paths(); // a single task never needs more paths
+    std::mutex visitor_mutex;
+    std::atomic<bool> limit_exceeded(false);
+    std::atomic<size_t> buffered_bytes(0); // memory of the paths collected by tasks, which have not been passed to the visitor
+    auto within_limits = [&]() // checks the deadline and the memory budget, polled by all tasks
+    {
+        std::lock_guard<std::mutex> lock(visitor_mutex);
+        if (!visitor.within_limits(buffered_bytes.load()))
+            limit_exceeded.store(true);
+        return !limit_exceeded.load();
+    };
+    if (stable_path_order)
+    {
+        // Each task collects its own paths. All tasks after cutoff_task are cancelled, since the visitor is done with the paths up to cutoff_task.
+        std::vector<DicePathList> task_paths(num_tasks);
+        std::vector<bool> task_finished(num_tasks, false);
+        std::vector<size_t> task_bytes(num_tasks, 0); // memory of the paths of each task counted in buffered_bytes
+        std::atomic<size_t> cutoff_task(num_tasks);
+        size_t first_unfinished_task = 0; // all tasks before first_unfinished_task have been passed to the visitor
+        thread_pool.run(num_tasks, [&](size_t task_idx, size_t /*worker_idx*/)
+            {
+                if (task_idx <= cutoff_task.load() && !limit_exceeded.load())
+                {
+                    search_closed_cycle_from_prefix(matrix, candidates_per_row, prefixes[task_idx], [&](const std::vector<int>& cycle)
+                        {
+                            task_paths[task_idx].append(DicePath(cycle));
+                            size_t bytes = task_paths[task_idx].memory_bytes();
+                            buffered_bytes += bytes - task_bytes[task_idx];
+                            task_bytes[task_idx] = bytes;
+                            return task_paths[task_idx].size() < max_task_paths && task_idx <= cutoff_task.load() && !limit_exceeded.load();
+                        },
+                        [&]() { return task_idx > cutoff_task.load() || !within_limits(); });
+                }
+                std::lock_guard<std::mutex> lock(visitor_mutex);
+                task_finished[task_idx] = true;
+                while (cutoff_task.load() == num_tasks && first_unfinished_task < num_tasks && task_finished[first_unfinished_task])
+                {
+                    for (DicePathList::const_iterator path_iter = task_paths[first_unfinished_task].cbegin(); path_iter != task_paths[first_unfinished_task].cend() && !visitor.done(); path_iter++)
+                        visitor.visit(*path_iter);
+                    task_paths[first_unfinished_task] = DicePathList(); // paths visited, release memory
+                    buffered_bytes -= task_bytes[first_unfinished_task];
+                    if (visitor.done())
+                        cutoff_task.store(first_unfinished_task);
+                    first_unfinished_task++;
+                }
+            });
+    }
+    else
+    {
+        // Paths are passed to the visitor immediately, a shared flag stops all tasks after the visitor is done
+        std::atomic<bool> visitor_done(false);
+        thread_pool.run(num_tasks, [&](size_t task_idx, size_t /*worker_idx*/)
+            {
+                if (visitor_done.load() || limit_exceeded.load())
+                    return;
+                search_closed_cycle_from_prefix(matrix, candidates_per_row, prefixes[task_idx], [&](const std::vector<int>& cycle)
+                    {
+                        DicePath path(cycle);
+                        std::lock_guard<std::mutex> lock(visitor_mutex);
+                        if (!visitor.visit(path))
+                            visitor_done.store(true);
+                        return !visitor_done.load();
+                    },
+                    [&]() { return visitor_done.load() || !within_limits(); });
+            });
+    }
+    PRINT_DBG_PATH_SEARCH("search_closed_cycle_parallel(" << m_name << "): " << num_tasks << " tasks, " << visitor.num_paths() << " closed paths" << std::endl);
+}
+
+// Symmetry-aware depth-first backtracking search of closed cycles, which contain all dice exactly once. Only the canonical cycle of each orbit
+// under the symmetries of the matrix is searched (see DiceGraph::CycleSymmetry), and all cycles of its orbit are passed to the visitor.
+template <typename DieType> void DiceSetT<DieType>::search_closed_cycle_symmetric(const BitMatrix& matrix, DicePathVisitor& visitor)
+{
+    DiceGraph::CycleSymmetry symmetry(matrix);
+    if (!symmetry.has_symmetry())
+        return search_closed_cycle_backtracking(matrix, visitor);
+    search_canonical_cycles(matrix, symmetry, [&](const std::vector<int>& cycle)
+        {
+            std::vector<std::vector<int>> orbit = symmetry.orbit(cycle);
+            bool continue_search = true;
+            for (size_t orbit_idx = 0; orbit_idx < orbit.size() && continue_search; orbit_idx++)
+                continue_search = visitor.visit(DicePath(orbit[orbit_idx]));
+            return continue_search;
+        },
+        [&]() { return !visitor.within_limits(); });
+}
+
+// Depth-first backtracking search of the canonical closed cycles of a matrix with a given symmetry. A path is extended only if it can be completed
+// to a canonical cycle, and visit(cycle) is called for each canonical cycle found, until visit returns false or stop_requested returns true.
+template <typename DieType> bool DiceSetT<DieType>::search_canonical_cycles(const BitMatrix& matrix, const DiceGraph::CycleSymmetry& symmetry,
+    const std::function<bool(const std::vector<int>& cycle)>& visit, const std::function<bool(void)>& stop_requested)
+{
+    std::vector<std::vector<int>> candidates_per_row = create_sorted_candidates(matrix);
+    return search_closed_cycle_from_prefix(matrix, candidates_per_row, { 0 },
+        [&](const std::vector<int>& cycle) { return !symmetry.is_canonical(cycle) || visit(cycle); },
+        stop_requested,
+        [&](const std::vector<int>& path, int die_idx) { return symmetry.extension_allowed(path, die_idx); });
+}
+
+// Depth-first backtracking search of closed cycles, which start with a given path prefix (starting at D_0) and contain all dice exactly once.
+// Calls visit(cycle) for each closed cycle (D_0, ..., D_0) found, until visit returns false or stop_requested (polled periodically) returns true.
+// If edge_allowed is given, a path is extended by a die only if edge_allowed(path, die_idx) returns true. Returns false, if the search has been stopped, or true otherwise.
+template <typename DieType> bool DiceSetT<DieType>::search_closed_cycle_from_prefix(const BitMatrix& matrix, const std::vector<std::vector<int>>& candidates_per_row, const std::vector<int>& prefix,
+    const std::function<bool(const std::vector<int>& cycle)>& visit, const std::function<bool(void)>& stop_requested,
+    const std::function<bool(const std::vector<int>& path, int die_idx)>& edge_allowed)
+{
+    const int N = (int)matrix.size();
+    assert(!prefix.empty() && prefix.front() == 0 && prefix.size() <= (size_t)N);
+    std::vector<int> path = prefix; // current path starting at D_0, extended and shortened in place
+    std::vector<size_t> next_candidate(N, 0); // next_candidate[n] is the position of the next successor of path[n] to try
+    std::vector<uint64_t> visited((N + 63) / 64, 0); // bit i is set, if die D_i is in the current path
+    path.reserve(N + 1);
+    for (size_t n = 0; n < path.size(); n++)
+        visited[path[n] / 64] |= ((uint64_t)1 << (path[n] % 64));
+    for (size_t step_cnt = 1; path.size() >= prefix.size(); step_cnt++)
     {
-        bool col_has_one = false;
-        for (int j = 0; j < (int)matrix.size() && !col_has_one; j++)
-            col_has_one = (matrix.at(i, j) == 1);
-        if (!col_has_one)
+        if (stop_requested && (step_cnt % 1024) == 0 && stop_requested())
             return false;
+        int row_idx = path.back();
+        size_t& candidate_pos = next_candidate[path.size() - 1];
+        if (path.size() == (size_t)N) // all dice visited, check for a closed cycle back to D_0 and backtrack
+        {
+            if (candidate_pos == 0 && matrix.at(row_idx, 0))
+            {
+                path.push_back(0);
+                bool continue_search = visit(path);
+                path.pop_back();
+                if (!continue_search)
+                    return false;
+            }
+            candidate_pos = candidates_per_row[row_idx].size();
+        }
+        if (candidate_pos < candidates_per_row[row_idx].size()) // extend the path by the next unvisited successor
+        {
+            int die_idx = candidates_per_row[row_idx][candidate_pos++];
+            if ((visited[die_idx / 64] & ((uint64_t)1 << (die_idx % 64))) == 0 && (!edge_allowed || edge_allowed(path, die_idx)))
+            {
+                visited[die_idx / 64] |= ((uint64_t)1 << (die_idx % 64));
+                next_candidate[path.size()] = 0;
+                path.push_back(die_idx);
+            }
+        }
+        else // all successors tried, backtrack
+        {
+            visited[row_idx / 64] &= ~((uint64_t)1 << (row_idx % 64));
+            path.pop_back();
+        }
     }
     return true;
 }
 
+// Returns the successors of each die sorted by sort_candidates_by_successors, i.e. in the same order as search_closed_cycle_recursive
+template <typename DieType> std::vector<std::vector<int>> DiceSetT<DieType>::create_sorted_candidates(const BitMatrix& matrix)
+{
+    std::vector<std::vector<int>> candidates_per_row = matrix.create_col_indices_foreach_row(); // all successors of die D_i with P(D_i > D_n) > 0.5
+    for (int row_idx = 0; row_idx < (int)candidates_per_row.size(); row_idx++)
+        sort_candidates_by_successors(candidates_per_row[row_idx], row_idx);
+    return candidates_per_row;
+}
+
+// Sorts the successors of die D_<row_idx> by index starting behind row_idx with wrap-around, i.e. row_idx+1, ..., N-1, 0, ..., row_idx-1,
+// such that neighbouring dice are tried first to increase the chance for a cycle.
+template <typename DieType> void DiceSetT<DieType>::sort_candidates_by_successors(std::vector<int>& candidates, int row_idx)
+{
+    std::sort(candidates.begin(), candidates.end(), std::less<int>());
+    std::rotate(candidates.begin(), std::upper_bound(candidates.begin(), candidates.end(), row_idx), candidates.end());
+}
+
+// Fast pre-check for intransitive chains: each die must have in- and out-degree >= 1 in the beat/lose-matrix, and all dice must
+// form a single strongly connected component, otherwise there is no closed cycle through all dice and the dice are not intransitive.
+// Both checks take O(N*N/64) resp. O(N+E) and reject most non-intransitive sets before the recursive search.
+template <typename DieType> bool DiceSetT<DieType>::precheck_intransitive_is_possible(const BitMatrix& matrix)
+{
+    if (!DiceGraph::has_min_degrees(matrix))
+        return false;
+    return DiceGraph::is_strongly_connected(matrix);
+}
+
 // Explicit template instantiation
 template class DiceSetT<Die>;
 template class DiceSetT<MultiDie>;
@@ -7,16 +7,26 @@
 #include <cfloat>
 #include <climits>
 #include <exception>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include "dice_graph.h"
 #include "dice_matrix.h"
 #include "dice_path.h"
+#include "dice_thread_pool.h"
 #include "dice_util.h"
 
 // Dice values can be int or int64_t
 typedef int64_t DieValueT;
 
+// Distribution of die values, i.e. a list of (value, multiplicity) pairs sorted by value in ascending order
+typedef std::vector<std::pair<DieValueT, size_t>> DieHistogramT;
+
 // class Die implements a single die and the base class for all dice
 class Die
 {
@@ -31,6 +41,7 @@ public:
   // Counts the number of eyes beating another die, i.e. returns the number of (*this > other) and (other > *this) sides.
   // Probability P(*this > other) = count_beats(other)[0] / (double)(NumSides * NumSides).
   // Probability P(other > *this) = count_beats(other)[1] / (double)(NumSides * NumSides).
+  // Both dice are compared by a sorted merge in O(M log M), or in O(M) if both dice are already sorted.
   virtual std::array<size_t, 2> count_beats(const Die& other) const;
 
   // Computes and returns the probability of beating another die, i.e. returns P(*this > other).
@@ -48,8 +59,8 @@ public:
   // Print the values of this die
   virtual std::string print(void) const { return DiceUtil::print(values(), 3); }
 
-  // Returns the eye values of this die
-  virtual inline std::vector<DieValueT>& values(void) { return m_values; }
+  // Returns the eye values of this die for changes. Not virtual: the values of a multi die are read-only, see MultiDie::values
+  inline std::vector<DieValueT>& values(void) { return m_values; }
 
   // Returns the eye values of this die
   virtual inline const std::vector<DieValueT>& values(void) const { return m_values; }
@@ -63,7 +74,8 @@ protected:
   bool values_sorted = false; // if true, m_values are sorted in ascending order, otherwise not
 };
 
-// class MultiDie implements a tuple of multiple dice simulating one die, where the value of rolling the multi die is the sum of each single die
+// class MultiDie implements a tuple of multiple dice simulating one die, where the value of rolling the multi die is the sum of each single die.
+// The distribution of sums is stored as a histogram of (sum, multiplicity) pairs instead of all M^K combinations of K M-sided dice.
 class MultiDie : public Die
 {
 public:
@@ -74,16 +86,68 @@ public:
   // Initializing constructor given the values of two single dice by two vectors
   MultiDie(const std::vector<std::vector<DieValueT>>& die_values);
 
+  // Counts the number of sums beating another die, i.e. returns the number of (*this > other) and (other > *this) outcomes by a weighted merge of both histograms.
+  // Probability P(*this > other) = count_beats(other)[0] / (double)(num_values() * other.num_values()).
+  virtual std::array<size_t, 2> count_beats(const Die& other) const;
+
+  // Replaces all values v_i by value v_i = factor * v_i + offset in all sides of all single dice
+  virtual void mul_add_values(DieValueT factor, DieValueT offset);
+
   // Print the values of all single dice of this dice tuple
   virtual std::string print(void) const;
 
+  // Returns all combinations of dice sums sorted in ascending order. Note: The sums are expanded from the histogram on demand, thread-safe.
+  virtual const std::vector<DieValueT>& values(void) const;
+
+  // The sums of a multi die are read-only, since changes would have no effect on the histogram. Use mul_add_values() to change a multi die.
+  std::vector<DieValueT>& values(void) = delete;
+
+  // Returns the number of combinations of dice sums, i.e. M^K for K M-sided dice
+  virtual inline size_t num_values(void) const { return m_num_values; }
+
+  // Returns the distribution of dice sums as a list of (sum, multiplicity) pairs sorted by sum in ascending order
+  inline const DieHistogramT& histogram(void) const { return m_histogram; }
+
+  // Returns the values (eyes) of each single die
+  inline const std::vector<std::vector<DieValueT>>& die_values(void) const { return m_die_values; }
+
 protected:
 
+  // Mutex guarding the expansion of m_sum_values on demand. A copy of a multi die gets its own mutex.
+  struct SumValuesMutex
+  {
+    SumValuesMutex() {}
+    SumValuesMutex(const SumValuesMutex&) {}
+    SumValuesMutex& operator=(const SumValuesMutex&) { return *this; }
+    std::mutex mutex;
+  };
+
   // Initializes the values of this multi die given the values (eyes) of each single die
   virtual void init(const std::vector<std::vector<DieValueT>> die_values);
 
   // the values (eyes) of each single die
   std::vector<std::vector<DieValueT>> m_die_values;
+
+  DieHistogramT m_histogram; // distribution of dice sums, i.e. list of (sum, multiplicity) pairs
+  size_t m_num_values = 0; // number of combinations of dice sums, i.e. sum of all multiplicities
+  mutable std::vector<DieValueT> m_sum_values; // all combinations of dice sums, expanded from m_histogram on demand
+  mutable SumValuesMutex m_sum_values_mutex; // guards the expansion of m_sum_values, e.g. by concurrent count_beats of other dice
+};
+
+// Engines to search closed cycles through all dice, see DiceSetT::set_cycle_search_strategy
+enum CycleSearchStrategy
+{
+  OPEN_PATH_LIST,       // Default: recursive search on a list of all open paths by search_closed_cycle_recursive, memory grows exponentially with the number of dice
+  BACKTRACKING,         // depth-first backtracking, extends a single path in place and marks visited dice in a bitmask, memory O(N)
+  PARALLEL_BACKTRACKING, // depth-first backtracking on multiple threads, split by path prefixes, see DiceSetT::set_parallel_cycle_search
+  SYMMETRIC_BACKTRACKING // depth-first backtracking on one cycle per orbit under the rotations and reflections of the die indices, which map the matrix to itself
+};
+
+// Strategy of DiceSetT::find_intransitive_path for beat and lose matrices with ties (tournaments are always solved by Camion's construction)
+enum FirstPathStrategy
+{
+  EXACT_FIRST_PATH,  // Default: the first cycle found by the search engine of search_intransitive_paths, exponential time in the worst case
+  ROTATION_EXTENSION // randomized rotation-extension heuristic with parallel restarts for large sets (see DiceGraph::find_hamiltonian_cycle_by_rotation_extension), exact search for small sets or if the heuristic fails
 };
 
 // A set of (possibly intransitive) dice
@@ -94,15 +158,111 @@ public:
   // Initializing constructor given a set of dice
   DiceSetT(const std::string& name = "", const std::vector<DieType>&dice = {}) : m_name(name), m_dice(dice) {}
 
+  // Initializing constructor, which moves a set of dice into this set
+  DiceSetT(const std::string& name, std::vector<DieType>&& dice) : m_name(name), m_dice(std::move(dice)) {}
+
   // Searches and returns a list of intransitive paths, each path contains a list of intransitive dice.
   // Example: const DicePathList& paths = search_intransitive_paths();
   // paths[0] = (D0, D1, D2, D3, D0) means: P(D0>D1) > 0.5, P(D1>D2) > 0.5, P(D2>D3) > 0.5, P(D3>D0) > 0.5.
   // paths[1] = (D0, D2, D3, D1, D0) means: P(D0>D2) > 0.5, P(D2>D3) > 0.5, P(D3>D1) > 0.5, P(D1>D0) > 0.5.
   const DicePathList& search_intransitive_paths(size_t max_final_paths = INT_MAX, size_t max_open_paths = INT_MAX);
 
+  // Anytime search of intransitive paths with a deadline and a memory budget, e.g. search_intransitive_paths(DiceSearchLimits::timeout(0.5), status).
+  // If a limit is exceeded, the search stops and returns the paths found so far, and status is set to SEARCH_DEADLINE_EXCEEDED resp.
+  // SEARCH_MEMORY_EXCEEDED. Such incomplete results are not cached, i.e. the next call searches again.
+  const DicePathList& search_intransitive_paths(const DiceSearchLimits& limits, DiceSearchStatus& status, size_t max_final_paths = INT_MAX, size_t max_open_paths = INT_MAX);
+
+  // Streams the intransitive paths without collecting them: calls visit(path) for each closed cycle as soon as it is found, beat cycles first,
+  // then lose cycles, in the same order as search_intransitive_paths. If the lose matrix is the transposed beat matrix (e.g. no ties, see
+  // BeatMatrix::lose_is_transposed_beat), the lose cycles are the reversed beat cycles in the same order, buffered for up to max_streamed_reversed_paths
+  // beat cycles. If there are more beat cycles, the buffer is released and the lose matrix is searched. The search stops, if visit returns false, after max_final_paths, or if
+  // a limit is exceeded. Returns the number of visited paths and optionally the status of the search. Example: stop at the first path with a bonus
+  // visit_intransitive_paths([&](const DicePath& path) { return path.print_bonus("").empty(); });
+  size_t visit_intransitive_paths(const std::function<bool(const DicePath& path)>& visit, size_t max_final_paths = INT_MAX, size_t max_open_paths = INT_MAX,
+    const DiceSearchLimits& limits = DiceSearchLimits(), DiceSearchStatus* status = 0);
+
+  // Visits one intransitive path of each orbit under the symmetries of the beat resp. lose matrix, e.g. the rotations of the die indices of
+  // Munnoz-Perera dice, and passes the number of paths in its orbit. Only one cycle per orbit is searched, i.e. for N circulant dice about N times
+  // faster than visit_intransitive_paths. The sum of all orbit sizes is the number of intransitive paths, and expand_path_orbit returns all paths of an orbit.
+  // The search stops, if visit returns false or a limit is exceeded. Returns the number of visited orbits and optionally the status of the search.
+  size_t visit_intransitive_path_orbits(const std::function<bool(const DicePath& path, size_t orbit_size)>& visit,
+    const DiceSearchLimits& limits = DiceSearchLimits(), DiceSearchStatus* status = 0);
+
+  // Returns all intransitive paths in the orbit of an intransitive path (D_0, ..., D_0), see visit_intransitive_path_orbits
+  std::vector<DicePath> expand_path_orbit(const DicePath& path);
+
   // Returns true, if this set of dice is intransitive, i.e. there is at least one intransitive path.
+  // Uses the paths found by search_intransitive_paths, if already searched, or find_intransitive_path otherwise.
   bool has_intransitive_paths();
 
+  // Finds a single intransitive path. If no pair of dice ties, the beat and lose matrices are tournaments, and a path is constructed in O(N*N)
+  // (Camion's theorem: a tournament has a closed cycle through all dice, if and only if it is strongly connected).
+  // Otherwise the first path found by the search engine of search_intransitive_paths is returned, or for large sets with the ROTATION_EXTENSION strategy
+  // a path found by a randomized heuristic and verified against the matrix (see set_first_path_strategy). Returns false, if the dice are not intransitive.
+  bool find_intransitive_path(DicePath& path);
+
+  // Counts the intransitive paths exactly without enumerating them, i.e. returns the number of paths found by search_intransitive_paths(INT_MAX).
+  // Closed cycles in the beat and lose matrix are counted by a subset dynamic programming (Held-Karp) in O(2^N*N*N) time for up to about 25 dice,
+  // using at most max_memory_bytes. If witness is given, it is set to one intransitive path, sampled uniformly from the beat cycles
+  // (or from the lose cycles, if there are no beat cycles), or to an empty path, if the dice are not intransitive.
+  // Returns false, if the number of dice or the number of paths is too large to be counted, or true otherwise.
+  bool count_intransitive_paths(uint64_t& num_paths, DicePath* witness = 0, size_t max_memory_bytes = ((size_t)1 << 30));
+
+  // Visits all simple intransitive cycles through min_length to max_length dice, i.e. also cycles through a subset of the dice like (D0, D2, D1, D0)
+  // in a set of 4 dice, which are not found by search_intransitive_paths. Beat cycles are visited first, then lose cycles, each starting at its smallest die.
+  // Use min_length = max_length = k for all cycles of k dice. The cycles are enumerated by Johnson's algorithm (see DiceGraph::enumerate_simple_cycles)
+  // on num_threads threads. The enumeration stops, if visit returns false. Returns the number of visited cycles.
+  size_t visit_simple_intransitive_cycles(const std::function<bool(const DicePath& path)>& visit, size_t min_length = 3, size_t max_length = INT_MAX, size_t num_threads = 1);
+
+  // Finds a longest intransitive cycle, i.e. an intransitive path through all dice by find_intransitive_path if possible, or otherwise the longest
+  // simple cycle through a subset of the dice in the beat or lose matrix. Returns false, if there is no intransitive cycle at all.
+  bool find_longest_intransitive_cycle(DicePath& path, size_t num_threads = 1);
+
+  // Finds the most robust intransitive path, i.e. the closed cycle through all dice with the largest bottleneck probability: the smallest P(D_i>D_i+1)
+  // of all edges of a beat path, resp. the smallest 1-P(D_i>D_i+1) of a lose path. Uses a branch and bound search on the cached beat matrix
+  // (see DiceGraph::find_bottleneck_hamiltonian_cycle) without enumerating all paths. Returns false, if the dice are not intransitive.
+  bool find_most_robust_intransitive_path(DicePath& path, double& bottleneck_probability);
+
+  // Sets the engine used by search_intransitive_paths. Both engines find the same cycles, but the backtracking engine
+  // returns them in depth-first order. Previously found paths are discarded.
+  void set_cycle_search_strategy(CycleSearchStrategy strategy) { m_cycle_search_strategy = strategy; m_intransitive_paths = DicePathList(); m_intransitive_paths_computed = false; }
+
+  // Returns the engine used by search_intransitive_paths
+  CycleSearchStrategy cycle_search_strategy(void) const { return m_cycle_search_strategy; }
+
+  // Sets the number of threads (or 0 for one thread per core) of the PARALLEL_BACKTRACKING engine. If stable_path_order is true (default),
+  // the parallel search returns the same paths in the same order as BACKTRACKING, otherwise the paths are returned in order of completion.
+  void set_parallel_cycle_search(size_t num_threads, bool stable_path_order = true) { m_num_search_threads = num_threads; m_stable_path_order = stable_path_order; m_intransitive_paths = DicePathList(); m_intransitive_paths_computed = false; }
+
+  // Sets the strategy of find_intransitive_path for matrices with ties. ROTATION_EXTENSION runs num_restarts restarts on num_threads threads
+  // (or one thread per core if num_threads is 0) for sets of at least min_dice dice, and the exact search for smaller sets.
+  void set_first_path_strategy(FirstPathStrategy strategy, size_t num_restarts = 16, size_t num_threads = 0, size_t min_dice = 32) { m_first_path_strategy = strategy; m_rotation_extension_restarts = num_restarts; m_rotation_extension_threads = num_threads; m_rotation_extension_min_dice = min_dice; }
+
+  // Sets the max. number of beat cycles, which are buffered by visit_intransitive_paths to pass the reversed beat cycles as lose cycles (default: 4096).
+  // If there are more beat cycles, the lose matrix is searched instead, i.e. the memory of the streaming search does not grow with the number of paths.
+  void set_max_streamed_reversed_paths(size_t max_reversed_paths) { m_max_streamed_reversed_paths = max_reversed_paths; }
+
+  // Sets the removal of duplicated cycles in the paths returned by search_intransitive_paths, e.g. CANONICAL_ROTATION_AND_MIRROR to keep
+  // a single path for each beat cycle and its mirror image in the lose matrix. Duplicates are dropped in O(1) by a hash map of canonical cycles.
+  // Previously found paths are discarded.
+  void set_cycle_deduplication(CycleDeduplication deduplication) { m_cycle_deduplication = deduplication; m_intransitive_paths = DicePathList(); m_intransitive_paths_computed = false; }
+
+  // Returns the exact win and loss counts of all pairs of dice. The matrix is computed once in parallel on first use and
+  // reused by all queries and prints, until the dice are changed by mul_add_values or set().
+  const BeatMatrix& beat_matrix(void);
+
+  // Returns the transitive closure of the beat relation (beat = true) resp. the lose relation (beat = false), e.g. reachability().can_reach(i, j)
+  // is true, if D_i beats D_j via a chain of beats. Computed once on the cached beat matrix, all queries take O(1).
+  const DiceGraph::ReachabilityIndex& reachability(bool beat = true);
+
+  // Returns the indices of all dice, which are part of an intransitive cycle through two or more dice of the beat or lose relation,
+  // without searching intransitive paths
+  std::vector<int> dice_on_intransitive_cycles(void);
+
+  // Returns P(D_i>D_j). Uses the cached beat matrix if available, otherwise only the given pair is counted,
+  // such that printing a path of a large set of dice does not require the beat matrix of all N*N pairs.
+  double probability_to_beat(int i, int j);
+
   // Prints the matrix of beat probabilities P(D_i>D_j) for all i, j.
   std::string print_probability_matrix();
 
@@ -125,16 +285,31 @@ public:
   // Returns the number of dice in this set
   size_t size(void) const { return m_dice.size(); }
 
-  // Returns the n.th dice in this set
-  DieType& at(size_t n) { return m_dice[n]; }
-
   // Returns the n.th dice in this set
   const DieType& at(size_t n) const { return m_dice[n]; }
 
+  // Replaces the n.th dice in this set. The cached beat matrix and intransitive paths are invalidated.
+  void set(size_t n, const DieType& die) { invalidate(); m_dice[n] = die; }
+
   // Returns the dice in this set
   const std::vector<DieType>& dice(void) const { return m_dice; }
 
-  // Replaces all values v_ij by value v_ij = factor * v_ij + offset in all dice
+  // Inserts a die at index idx, e.g. between D_i and D_i+1 for idx = i+1. If the beat matrix has been computed, only the row and column of the new die
+  // are counted (N pairs instead of N*N pairs, see BeatMatrix::insert). The indices of all dice >= idx are incremented, and the cached paths are discarded.
+  void insert(size_t idx, const DieType& die);
+
+  // Inserts multiple dice at once: new_dice[k] = (idx, die) inserts die before the current die D_idx (or appends it for idx = size()). The new dice must be
+  // sorted by idx in ascending order. If the beat matrix has been computed, the counts are moved once and only the K*N pairs of K new dice are counted.
+  void insert(const std::vector<std::pair<size_t, DieType>>& new_dice);
+
+  // Appends a die, see insert
+  void append(const DieType& die) { insert(m_dice.size(), die); }
+
+  // Removes the die at index idx and its row and column of the beat matrix. The indices of all dice > idx are decremented, and the cached paths are discarded.
+  void remove(size_t idx);
+
+  // Replaces all values v_ij by value v_ij = factor * v_ij + offset in all dice. An increasing affine map (factor > 0) of all values keeps all comparisons
+  // between dice, i.e. the cached beat matrix and intransitive paths are kept (for tuples of dice only with offset 0, since tuples of different sizes change differently).
   void mul_add_values(DieValueT factor, DieValueT offset);
 
   // Returns the minimum of all values of all dice
@@ -142,19 +317,77 @@ public:
 
 protected:
 
+  // Passes the intransitive paths to a visitor, beat cycles first, then lose cycles. Up to max_reversed_paths beat cycles are buffered as lose cycles.
+  void visit_intransitive_paths(DicePathVisitor& visitor, size_t max_open_paths, size_t max_reversed_paths);
+
   // Searches and returns a list of closed cycles (i.e. an intransitive chain of dice), which contain all dice exactly once.
-  DicePathList search_closed_cycle(const SqrMatrix<int>& matrix, size_t max_final_paths, size_t max_open_paths);
+  DicePathList search_closed_cycle(const BitMatrix& matrix, size_t max_final_paths, size_t max_open_paths);
+
+  // Searches closed cycles, which contain all dice exactly once, and passes each cycle to the visitor as soon as it is found.
+  void search_closed_cycle(const BitMatrix& matrix, DicePathVisitor& visitor, size_t max_open_paths);
 
   // Recursive search of a closed cycle, which contains all dice exactly once.
-  void search_closed_cycle_recursive(const std::vector<std::vector<int>>& col_indices_per_row, DicePathList& open_path_list, DicePathList& closed_path_list, int row_idx, size_t max_final_paths, size_t max_open_paths);
+  void search_closed_cycle_recursive(const std::vector<std::vector<int>>& col_indices_per_row, DiceOpenPathList& open_path_list, DicePathVisitor& visitor, int row_idx, size_t max_open_paths);
+
+  // Depth-first backtracking search of closed cycles, which contain all dice exactly once. A single path is extended in place
+  // and visited dice are marked in a bitmask, i.e. memory is O(N) independent of the number of partial paths.
+  void search_closed_cycle_backtracking(const BitMatrix& matrix, DicePathVisitor& visitor);
+
+  // Parallel depth-first backtracking search of closed cycles, which contain all dice exactly once. The search tree is split into tasks
+  // by path prefixes of 1 to 3 successors of D_0, which run on a work-stealing thread pool. The visitor is called by one thread at a time.
+  void search_closed_cycle_parallel(const BitMatrix& matrix, DicePathVisitor& visitor, size_t num_threads, bool stable_path_order);
+
+  // Symmetry-aware depth-first backtracking search of closed cycles, which contain all dice exactly once. If rotations (e.g. the circulant matrix
+  // of Munnoz-Perera dice) or reflections of the die indices map the matrix to itself, only the canonical cycle of each orbit is searched, and
+  // all cycles of its orbit are passed to the visitor. Otherwise the search falls back to search_closed_cycle_backtracking.
+  void search_closed_cycle_symmetric(const BitMatrix& matrix, DicePathVisitor& visitor);
+
+  // Depth-first backtracking search of the canonical closed cycles of a matrix with a given symmetry, i.e. one cycle of each orbit.
+  // Calls visit(cycle) for each canonical cycle found, until visit returns false or stop_requested returns true. Returns false, if the search has been stopped.
+  static bool search_canonical_cycles(const BitMatrix& matrix, const DiceGraph::CycleSymmetry& symmetry,
+    const std::function<bool(const std::vector<int>& cycle)>& visit, const std::function<bool(void)>& stop_requested = nullptr);
+
+  // Depth-first backtracking search of closed cycles, which start with a given path prefix (starting at D_0) and contain all dice exactly once.
+  // Calls visit(cycle) for each closed cycle (D_0, ..., D_0) found, until visit returns false or stop_requested (polled periodically) returns true.
+  // If edge_allowed is given, a path is extended by a die only if edge_allowed(path, die_idx) returns true. Returns false, if the search has been stopped, or true otherwise.
+  static bool search_closed_cycle_from_prefix(const BitMatrix& matrix, const std::vector<std::vector<int>>& candidates_per_row, const std::vector<int>& prefix,
+    const std::function<bool(const std::vector<int>& cycle)>& visit, const std::function<bool(void)>& stop_requested = nullptr,
+    const std::function<bool(const std::vector<int>& path, int die_idx)>& edge_allowed = nullptr);
+
+  // Returns the successors of each die sorted by sort_candidates_by_successors, i.e. in the same order as search_closed_cycle_recursive
+  static std::vector<std::vector<int>> create_sorted_candidates(const BitMatrix& matrix);
+
+  // Sorts the successors of die D_<row_idx> by index starting behind row_idx with wrap-around, i.e. row_idx+1, ..., N-1, 0, ..., row_idx-1,
+  // such that neighbouring dice are tried first to increase the chance for a cycle.
+  static void sort_candidates_by_successors(std::vector<int>& candidates, int row_idx);
+
+  // Fast pre-check for intransitive chains: each die must have in- and out-degree >= 1 in the beat/lose-matrix, and all dice must
+  // form a single strongly connected component, otherwise there is no closed cycle through all dice and the dice are not intransitive.
+  bool precheck_intransitive_is_possible(const BitMatrix& matrix);
+
+  // Invalidates the cached beat matrix and intransitive paths after the dice have been changed
+  void invalidate(void);
 
-  // Fast pre-check for intransitive chains: All columns of a beat/lose-matrix must have at least one "1", otherwise the dice are not intransitive.
-  bool precheck_intransitive_is_possible(const SqrMatrix<int>& matrix);
+  // Invalidates the cached intransitive paths and reachability, but keeps the beat matrix (e.g. after it has been updated incrementally)
+  void invalidate_paths(void);
 
   std::string m_name; // descriptional name like "Efrons dice"
   std::vector<DieType> m_dice; // the dice in this set
+  BeatMatrix m_beat_matrix; // exact win and loss counts of all pairs of dice, computed once on first use
+  DiceGraph::ReachabilityIndex m_reachability[2]; // transitive closure of the beat and lose relation, computed once on first use
+  bool m_reachability_computed = false; // becomes true after m_reachability has been computed
   DicePathList m_intransitive_paths; // list of all intransitive paths (which is empty if the dice are not intransitive)
   bool m_intransitive_paths_computed = false; // becomes true after m_intransitive_paths has been computed
+  DiceSearchStatus m_intransitive_paths_status = SEARCH_COMPLETE; // status of the search of m_intransitive_paths
+  CycleSearchStrategy m_cycle_search_strategy = CycleSearchStrategy::OPEN_PATH_LIST; // engine used by search_closed_cycle
+  size_t m_num_search_threads = 0; // number of threads of the parallel search, or 0 for one thread per core
+  bool m_stable_path_order = true; // if true, the parallel search returns the paths in the same order as the sequential search
+  CycleDeduplication m_cycle_deduplication = NO_DEDUPLICATION; // removal of duplicated cycles in m_intransitive_paths
+  size_t m_max_streamed_reversed_paths = 4096; // max. number of beat cycles buffered as lose cycles by the streaming visit_intransitive_paths
+  FirstPathStrategy m_first_path_strategy = FirstPathStrategy::EXACT_FIRST_PATH; // strategy of find_intransitive_path for matrices with ties
+  size_t m_rotation_extension_restarts = 16; // number of restarts of the rotation-extension heuristic
+  size_t m_rotation_extension_threads = 0; // number of threads of the rotation-extension heuristic, or 0 for one thread per core
+  size_t m_rotation_extension_min_dice = 32; // min. number of dice for the rotation-extension heuristic, smaller sets are searched exactly
 
 }; // end of class DiceSetT
 
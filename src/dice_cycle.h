@@ -0,0 +1,209 @@
+// Growable cycle of dice for the iterative insertion of intransitive dice
+#pragma once
+#include <algorithm>
+#include <assert.h>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "dice.h"
+
+// DiceCycle stores the dice of a closed path (D_0, D_1, ..., D_(N-1), D_0) or an open path (D_0, D_1, ..., D_(N-1)) in path order, i.e. the path
+// is implicit and D_n is followed by D_(n+1). The dice are stored in chunks of up to max_chunk_size dice: new dice are spliced in place by moving
+// the dice of the affected chunks only, without copying the values of any die, and without a copy of the whole set or path.
+class DiceCycle
+{
+public:
+
+  static constexpr size_t DEFAULT_CHUNK_SIZE = 4096; // default max. number of dice per chunk
+
+  // Creates an empty cycle
+  DiceCycle(bool closed = true, size_t max_chunk_size = DEFAULT_CHUNK_SIZE) : m_closed(closed), m_max_chunk_size(std::max<size_t>(1, max_chunk_size)) {}
+
+  // Copies the dice of a path through a set of dice, i.e. the cycle is closed if path.front() == path.back(), and open otherwise
+  DiceCycle(const DiceSet& dice_set, const DicePath& path, size_t max_chunk_size = DEFAULT_CHUNK_SIZE) : m_max_chunk_size(std::max<size_t>(1, max_chunk_size))
+  {
+    m_closed = (path.size() > 1 && path.front() == path.back());
+    size_t num_dice = m_closed ? path.size() - 1 : path.size();
+    for (size_t n = 0; n < num_dice; n++)
+      append(dice_set.at(path.at(n)));
+  }
+
+  // Returns the number of dice
+  size_t size(void) const { return m_size; }
+
+  // Returns true, if the last die is followed by the first die
+  bool closed(void) const { return m_closed; }
+
+  // Returns the number of dice indices of the implicit path, i.e. size() + 1 for a closed cycle (D_0, ..., D_(N-1), D_0)
+  size_t path_size(void) const { return (m_closed && m_size > 0) ? (m_size + 1) : m_size; }
+
+  // Returns the number of edges D_n -> D_(n+1), i.e. size() for a closed cycle and size() - 1 for an open path
+  size_t num_edges(void) const { return m_closed ? m_size : (m_size > 0 ? m_size - 1 : 0); }
+
+  // Returns the n.th die in path order in O(log(number of chunks))
+  Die& at(size_t n)
+  {
+    assert(n < m_size);
+    size_t chunk_idx = chunk_index(n);
+    return m_chunks[chunk_idx][n - m_chunk_offsets[chunk_idx]];
+  }
+
+  // Returns the n.th die in path order in O(log(number of chunks))
+  const Die& at(size_t n) const
+  {
+    assert(n < m_size);
+    size_t chunk_idx = chunk_index(n);
+    return m_chunks[chunk_idx][n - m_chunk_offsets[chunk_idx]];
+  }
+
+  // Appends a die at the end of the path
+  void append(Die die)
+  {
+    if (m_chunks.empty() || m_chunks.back().size() >= m_max_chunk_size)
+    {
+      m_chunks.push_back(std::vector<Die>());
+      m_chunk_offsets.push_back(m_size);
+    }
+    m_chunks.back().push_back(std::move(die));
+    m_size++;
+  }
+
+  // Inserts new dice in place: new_dice[k] = (n, die) inserts die behind D_n, i.e. between D_n and D_(n+1). The new dice must be sorted by n
+  // in ascending order and are moved into the cycle. The indices of all dice behind an inserted die are incremented.
+  void splice(std::vector<std::pair<size_t, Die>>& new_dice)
+  {
+    if (new_dice.empty())
+      return;
+    std::vector<std::vector<Die>> chunks;
+    chunks.reserve(m_chunks.size() + new_dice.size() / m_max_chunk_size + 1);
+    size_t new_die_idx = 0;
+    for (size_t chunk_idx = 0; chunk_idx < m_chunks.size(); chunk_idx++)
+    {
+      std::vector<Die>& old_chunk = m_chunks[chunk_idx];
+      size_t chunk_begin = m_chunk_offsets[chunk_idx], chunk_end = chunk_begin + old_chunk.size();
+      if (new_die_idx >= new_dice.size() || new_dice[new_die_idx].first >= chunk_end) // no new dice in this chunk => keep the chunk
+      {
+        chunks.push_back(std::move(old_chunk));
+        continue;
+      }
+      std::vector<Die> chunk;
+      chunk.reserve(std::min(m_max_chunk_size, 2 * old_chunk.size())); // at most one new die per edge
+      for (size_t n = chunk_begin; n < chunk_end; n++)
+      {
+        append_to_chunk(chunks, chunk, std::move(old_chunk[n - chunk_begin]));
+        for (; new_die_idx < new_dice.size() && new_dice[new_die_idx].first == n; new_die_idx++)
+          append_to_chunk(chunks, chunk, std::move(new_dice[new_die_idx].second));
+      }
+      std::vector<Die>().swap(old_chunk); // release the moved dice of the old chunk
+      if (!chunk.empty())
+        chunks.push_back(std::move(chunk));
+    }
+    assert(new_die_idx == new_dice.size());
+    m_size += new_die_idx;
+    m_chunks.swap(chunks);
+    m_chunk_offsets.resize(m_chunks.size());
+    for (size_t chunk_idx = 0, offset = 0; chunk_idx < m_chunks.size(); offset += m_chunks[chunk_idx].size(), chunk_idx++)
+      m_chunk_offsets[chunk_idx] = offset;
+  }
+
+  // Replaces all values v_ij by value v_ij = factor * v_ij + offset in all dice
+  void mul_add_values(DieValueT factor, DieValueT offset)
+  {
+    for (size_t chunk_idx = 0; chunk_idx < m_chunks.size(); chunk_idx++)
+      for (size_t n = 0; n < m_chunks[chunk_idx].size(); n++)
+        m_chunks[chunk_idx][n].mul_add_values(factor, offset);
+  }
+
+  // Replaces all values v_ij by value v_ij = f(v_ij) in all dice. A strictly increasing map f keeps all comparisons between dice and the order of sorted values.
+  template <typename Function> void transform_values(const Function& f)
+  {
+    for (size_t chunk_idx = 0; chunk_idx < m_chunks.size(); chunk_idx++)
+      for (size_t n = 0; n < m_chunks[chunk_idx].size(); n++)
+        for (DieValueT& value : m_chunks[chunk_idx][n].values())
+          value = f(value);
+  }
+
+  // Returns the minimum of all values of all dice
+  DieValueT min_die_value(void) const
+  {
+    DieValueT min_value = 0;
+    bool first_value = true;
+    for (size_t chunk_idx = 0; chunk_idx < m_chunks.size(); chunk_idx++)
+    {
+      for (size_t n = 0; n < m_chunks[chunk_idx].size(); n++)
+      {
+        const std::vector<DieValueT>& values = m_chunks[chunk_idx][n].values();
+        if (!values.empty())
+        {
+          DieValueT die_min_value = *std::min_element(values.begin(), values.end());
+          min_value = first_value ? die_min_value : std::min(min_value, die_min_value);
+          first_value = false;
+        }
+      }
+    }
+    return min_value;
+  }
+
+  // Returns the implicit path (0, 1, ..., N-1, 0) resp. (0, 1, ..., N-1) through the dice
+  DicePath path(void) const
+  {
+    std::vector<int> dice_idx;
+    dice_idx.reserve(path_size());
+    for (size_t n = 0; n < m_size; n++)
+      dice_idx.push_back((int)n);
+    if (m_closed && m_size > 0)
+      dice_idx.push_back(0);
+    return DicePath(dice_idx);
+  }
+
+  // Returns a copy of all dice in path order
+  std::vector<Die> dice(void) const
+  {
+    std::vector<Die> dice;
+    dice.reserve(m_size);
+    for (size_t chunk_idx = 0; chunk_idx < m_chunks.size(); chunk_idx++)
+      dice.insert(dice.end(), m_chunks[chunk_idx].begin(), m_chunks[chunk_idx].end());
+    return dice;
+  }
+
+  // Moves all dice in path order out of the cycle, e.g. into a DiceSet. The cycle is empty afterwards.
+  std::vector<Die> release_dice(void)
+  {
+    std::vector<Die> dice;
+    dice.reserve(m_size);
+    for (size_t chunk_idx = 0; chunk_idx < m_chunks.size(); chunk_idx++)
+    {
+      std::move(m_chunks[chunk_idx].begin(), m_chunks[chunk_idx].end(), std::back_inserter(dice));
+      std::vector<Die>().swap(m_chunks[chunk_idx]);
+    }
+    m_chunks.clear();
+    m_chunk_offsets.clear();
+    m_size = 0;
+    return dice;
+  }
+
+protected:
+
+  // Returns the index of the chunk containing the n.th die
+  size_t chunk_index(size_t n) const
+  {
+    return (std::upper_bound(m_chunk_offsets.begin(), m_chunk_offsets.end(), n) - m_chunk_offsets.begin()) - 1;
+  }
+
+  // Appends a die to a chunk, and moves the chunk to a list of chunks if it is full
+  void append_to_chunk(std::vector<std::vector<Die>>& chunks, std::vector<Die>& chunk, Die&& die) const
+  {
+    chunk.push_back(std::move(die));
+    if (chunk.size() >= m_max_chunk_size)
+    {
+      chunks.push_back(std::move(chunk));
+      chunk = std::vector<Die>();
+    }
+  }
+
+  std::vector<std::vector<Die>> m_chunks; // the dice in path order, stored in chunks of up to m_max_chunk_size dice
+  std::vector<size_t> m_chunk_offsets; // m_chunk_offsets[c] is the index of the first die in chunk c
+  size_t m_size = 0; // total number of dice
+  bool m_closed = true; // if true, the last die is followed by the first die
+  size_t m_max_chunk_size = DEFAULT_CHUNK_SIZE; // max. number of dice per chunk
+};
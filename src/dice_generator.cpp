@@ -273,19 +273,102 @@ namespace DiceGenerator
         return double_dice_sets;
     }
 
+    // Adds the statistics of another run, e.g. of another thread
+    void FindDieStatistics::add(const FindDieStatistics& other)
+    {
+        num_searches += other.num_searches;
+        num_found += other.num_found;
+        num_simple_searches += other.num_simple_searches;
+        num_simple_found += other.num_simple_found;
+        num_three_level_searches += other.num_three_level_searches;
+        simple_seconds += other.simple_seconds;
+        three_level_seconds += other.three_level_seconds;
+        num_sampled_three_level_searches += other.num_sampled_three_level_searches;
+        sampled_three_level_seconds += other.sampled_three_level_seconds;
+    }
+
+    // Returns the fraction of SIMPLE searches falling back to 3 level insertion
+    double FindDieStatistics::fallback_rate(void) const
+    {
+        return num_simple_searches > 0 ? (double)(num_simple_searches - num_simple_found) / (double)num_simple_searches : 0.0;
+    }
+
+    // Returns the estimated time saved by trying SIMPLE first, i.e. the average time of the sampled 3 level insertions for each die found by SIMPLE,
+    // minus the time of all SIMPLE searches
+    double FindDieStatistics::saved_seconds(void) const
+    {
+        if (!has_saved_seconds())
+            return 0.0;
+        return num_simple_found * (sampled_three_level_seconds / num_sampled_three_level_searches) - simple_seconds;
+    }
+
+    // Prints the statistics
+    std::string FindDieStatistics::print(void) const
+    {
+        std::stringstream str;
+        str << num_found << " of " << num_searches << " dice found, " << num_simple_found << " of " << num_simple_searches << " by simple search ("
+            << std::fixed << std::setprecision(3) << simple_seconds << " sec), " << num_three_level_searches << " 3 level insertion searches (" << three_level_seconds << " sec), "
+            << "fallback rate " << std::setprecision(2) << (100.0 * fallback_rate()) << "%, estimated time saved ";
+        if (has_saved_seconds())
+            str << std::setprecision(3) << saved_seconds() << " sec (3 level insertion timed on " << num_sampled_three_level_searches << " dice found by simple search)";
+        else
+            str << "n/a (no 3 level insertion sampled)";
+        return str.str();
+    }
+
     // Tries to find a die die_j "between" two dice die_i and die_k with P(die_i>die_j) > 0.5 && P(die_j>die_k) > 0.5.
-    Die find_die_between_two_others(Die& die_i, Die& die_k, FindDieStrategy strategy)
+    Die find_die_between_two_others(Die& die_i, Die& die_k, FindDieStrategy strategy, FindDieStatistics* statistics)
     {
-        if (strategy == FindDieStrategy::SIMPLE) // fast, finds most dice, but not all (counter examples exist)
-            return find_die_between_two_others_simple(die_i, die_k);
-        // default: 3-level-insertion
-        return find_die_between_two_others_3_level_insertion(die_i, die_k);
+        if (!statistics)
+        {
+            if (strategy == FindDieStrategy::SIMPLE) // fast, finds most dice, but not all (counter examples exist)
+                return find_die_between_two_others_simple(die_i, die_k);
+            if (strategy == FindDieStrategy::ADAPTIVE) // simple first, 3-level-insertion if the simple search fails
+            {
+                Die die_j = find_die_between_two_others_simple(die_i, die_k);
+                if (die_j.num_values() == die_i.num_values())
+                    return die_j;
+            }
+            // default: 3-level-insertion
+            return find_die_between_two_others_3_level_insertion(die_i, die_k);
+        }
+        statistics->num_searches++;
+        if (strategy == FindDieStrategy::SIMPLE || strategy == FindDieStrategy::ADAPTIVE)
+        {
+            std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+            Die die_j = find_die_between_two_others_simple(die_i, die_k);
+            statistics->simple_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+            statistics->num_simple_searches++;
+            bool found = (die_j.num_values() == die_i.num_values());
+            statistics->num_simple_found += found ? 1 : 0;
+            if (found && strategy == FindDieStrategy::ADAPTIVE && statistics->three_level_sample_interval > 0 && (statistics->num_simple_found - 1) % statistics->three_level_sample_interval == 0)
+            {
+                start_time = std::chrono::steady_clock::now(); // optionally time the 3 level insertion, which SIMPLE has saved, on a sample of the dice found by SIMPLE
+                find_die_between_two_others_3_level_insertion(die_i, die_k);
+                statistics->sampled_three_level_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+                statistics->num_sampled_three_level_searches++;
+            }
+            if (found || strategy == FindDieStrategy::SIMPLE)
+            {
+                statistics->num_found += found ? 1 : 0;
+                return die_j;
+            }
+        }
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+        Die die_j = find_die_between_two_others_3_level_insertion(die_i, die_k);
+        statistics->three_level_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        statistics->num_three_level_searches++;
+        statistics->num_found += (die_j.num_values() == die_i.num_values()) ? 1 : 0;
+        return die_j;
     }
 
     // Searches for a die die_j "between" two dice die_i and die_k with P(die_i>die_j) > 0.5 && P(die_j>die_k) > 0.5.
     // Let die_i and die_k be two N-sided dice with P(die_i>die_k) > 0.5, where die_i[n] is the n-th value of die_i and
     // die_k[n] is the n-th value of die_k, with 0 <= n < N for N-sided dice. 
     // This function uses a 3-level insertion algorithm and assumes P(die_i>die_k) > 0.5.
+    // The cdfs of both dice are counted incrementally over the merged sorted values, and the win counts of a 3-level candidate die
+    // with values L, T, H and multiplicities mL, mM, mH are computed arithmetically, i.e. a die is created only for the die found.
+    // The search takes O(M log M) for the thresholds plus O(1) per candidate, and returns the same die as building and comparing all candidates.
     Die find_die_between_two_others_3_level_insertion(Die& die_i, Die& die_k)
     {
         die_i.sort_values();
@@ -297,23 +380,29 @@ namespace DiceGenerator
         if (pDiDk > 0.5) // P(die_i>die_k) > 0.5: find die_j with P(die_i>die_j) > 0.5 and P(die_j>die_k) > 0.5
         {
             // All dice values sorted
-            std::vector<DieValueT> dice_values;
-            dice_values.reserve(2 * M);
-            dice_values.insert(dice_values.end(), A.begin(), A.end());
-            dice_values.insert(dice_values.end(), B.begin(), B.end());
-            std::sort(dice_values.begin(), dice_values.end(), std::less<DieValueT>());
-            std::vector<double> candidates; // candidates for threshold t: mean of two dice values
-            candidates.reserve(2 * M);
+            std::vector<DieValueT> dice_values(2 * M);
+            std::merge(A.begin(), A.end(), B.begin(), B.end(), dice_values.begin());
+            DieValueT L = std::min(A.front(), B.front()) - 1; // min(A) = A.front(), min(B) = B.front(), since A and B are sorted
+            DieValueT H = std::max(A.back(), B.back()) + 1; // max(A) = A.back(), max(B) = B.back(), since A and B are sorted
+            // Number of values a > v in A resp. b < v in B, i.e. the number of wins of A against a die value v resp. of a die value v against B
+            auto wins_of_A = [&](DieValueT v) { return (size_t)(A.end() - std::upper_bound(A.begin(), A.end(), v)); };
+            auto wins_over_B = [&](DieValueT v) { return (size_t)(std::lower_bound(B.begin(), B.end(), v) - B.begin()); };
+            size_t A_wins_L = wins_of_A(L), A_wins_H = wins_of_A(H), L_wins_B = wins_over_B(L), H_wins_B = wins_over_B(H);
+            size_t cnt_A = 0, cnt_B = 0; // number of values a <= t in A and b <= t in B
             for (size_t n = 1; n < dice_values.size(); n++)
-                if (dice_values[n - 1] != dice_values[n]) // ignore duplicates in dice_values
-                    candidates.push_back(0.5 * (dice_values[n - 1] + dice_values[n]));
-            for (int candidate_idx = 0; candidate_idx < candidates.size(); candidate_idx++)
             {
-                double t = candidates[candidate_idx]; // current threshold
-                double FAt = DiceUtil::cdf(A, t); // sum(a <= t for a in A) / M
-                double FBt = DiceUtil::cdf(B, t); // sum(b <= t for b in B) / M
+                if (dice_values[n - 1] == dice_values[n]) // ignore duplicates in dice_values
+                    continue;
+                double t = 0.5 * (dice_values[n - 1] + dice_values[n]); // current threshold t: mean of two dice values
+                for (; cnt_A < M && A[cnt_A] <= dice_values[n - 1]; cnt_A++) {}
+                for (; cnt_B < M && B[cnt_B] <= dice_values[n - 1]; cnt_B++) {}
+                double FAt = (double)cnt_A / (double)M; // sum(a <= t for a in A) / M
+                double FBt = (double)cnt_B / (double)M; // sum(b <= t for b in B) / M
                 if (FAt < FBt)
                 {
+                    DieValueT T = (DieValueT)(t + FLT_EPSILON); // integer threshold
+                    // Convert to integer values with (t + FLT_EPSILON) rounded up and down, i.e. candidate die C[n] has the values L, T+n, H
+                    size_t A_wins_T[2] = { wins_of_A(T), wins_of_A(T + 1) }, T_wins_B[2] = { wins_over_B(T), wins_over_B(T + 1) };
                     for (size_t mM = 1; mM < M; mM++)
                     {
                         size_t Lmin = (size_t)(0.5 * M - mM * (1.0 - FAt)) + 1;
@@ -324,29 +413,22 @@ namespace DiceGenerator
                         {
                             size_t mL = Lmin;
                             size_t mH = M - mM - mL;
-                            DieValueT L = std::min(A.front(), B.front()) - 1; // min(A) = A.front(), min(B) = B.front(), since A and B are sorted
-                            DieValueT H = std::max(A.back(), B.back()) + 1; // max(A) = A.back(), max(B) = B.back(), since A and B are sorted
-                            DieValueT T = (DieValueT)(t + FLT_EPSILON); // integer threshold
-                            // Convert to integer values with (t + FLT_EPSILON) rounded up and down
-                            std::vector<DieValueT> C[2];
-                            C[0].reserve(M);
-                            C[1].reserve(M);
-                            DiceUtil::append(C[0], L, mL);
-                            DiceUtil::append(C[1], L, mL);
-                            DiceUtil::append(C[0], T, mM);
-                            DiceUtil::append(C[1], T + 1, mM);
-                            DiceUtil::append(C[0], H, mH);
-                            DiceUtil::append(C[1], H, mH);
-                            assert(C[0].size() == M && C[1].size() == M);
                             for (int n = 0; n < 2; n++)
                             {
-                                Die die_j(C[n]);
-                                double pDiDj = die_i.probability_to_beat(die_j);
-                                double pDjDk = die_j.probability_to_beat(die_k);
-                                if (pDiDj > 0.5 && pDjDk > 0.5)
+                                size_t wins_ij = mL * A_wins_L + mM * A_wins_T[n] + mH * A_wins_H; // number of (die_i > die_j) outcomes
+                                size_t wins_jk = mL * L_wins_B + mM * T_wins_B[n] + mH * H_wins_B; // number of (die_j > die_k) outcomes
+                                if (2 * wins_ij > M * M && 2 * wins_jk > M * M) // P(die_i>die_j) > 0.5 && P(die_j>die_k) > 0.5
+                                {
+                                    std::vector<DieValueT> C;
+                                    C.reserve(M);
+                                    DiceUtil::append(C, L, mL);
+                                    DiceUtil::append(C, T + n, mM);
+                                    DiceUtil::append(C, H, mH);
+                                    Die die_j(C);
+                                    die_j.sort_values();
                                     return die_j; // success: P(die_i>die_k) > 0.5, P(die_i>die_j) > 0.5, P(die_j>die_k) > 0.5
+                                }
                             }
-
                         }
                     }
                 }
@@ -421,108 +503,210 @@ namespace DiceGenerator
     // Iteratively insert new dice D_j between D_i and D_(i+1), such that P(D_i > D_j) > 0.5 and P(D_j > D_(i+1)) > 0.5.
     // Start with a given set of dice and a given intransitive path, and repeat the process until
     // the given max. number of dice are reached, or no new dice D_j can be found.
-    // If initial_dice_path is intransitive, extended_dice_path will also be intransitive
-    bool extend_set_by_intransitive_dice_insertion(const DiceSet& initial_dice_set, const DicePath& initial_dice_path, size_t max_num_dice, DiceSet& extended_dice_set, DicePath& extended_dice_path, FindDieStrategy strategy, int max_iterations, DiceLogger* logger)
+    // If initial_dice_path is intransitive, extended_dice_path will also be intransitive. The dice are extended in place in a DiceCycle,
+    // i.e. neither the set nor the path are copied in each round, and the extended set is created once at the end.
+    bool extend_set_by_intransitive_dice_insertion(const DiceSet& initial_dice_set, const DicePath& initial_dice_path, size_t max_num_dice, DiceSet& extended_dice_set, DicePath& extended_dice_path, FindDieStrategy strategy, int max_iterations, DiceLogger* logger, size_t num_threads, RetryStrategy retry_strategy,
+        FindDieStatistics* statistics)
     {
         std::string extended_dice_name = extended_dice_set.name().empty() ? initial_dice_set.name() : extended_dice_set.name();
-        extended_dice_set = DiceSet(extended_dice_name, initial_dice_set.dice());
-        extended_dice_path = initial_dice_path;
         if (initial_dice_set.size() >= max_num_dice)
+        {
+            extended_dice_set = DiceSet(extended_dice_name, initial_dice_set.dice());
+            extended_dice_path = initial_dice_path;
             return true;
-        DieValueT min_die_value = extended_dice_set.min_die_value();
+        }
+        DiceCycle dice_cycle(initial_dice_set, initial_dice_path);
+        DieValueT min_die_value = initial_dice_set.min_die_value();
         if (min_die_value < 1) // normalize min dice value 1
-            extended_dice_set.mul_add_values(1, 1 - min_die_value);
-        while (extended_dice_set.size() < max_num_dice)
+            dice_cycle.mul_add_values(1, 1 - min_die_value);
+        bool dice_inserted = false;
+        while (dice_cycle.size() < max_num_dice)
         {
-            DiceSet work_dice_set;
-            DicePath work_dice_path;
-            if (extend_set_by_intransitive_dice_insertion_once(extended_dice_set, extended_dice_path, max_num_dice, work_dice_set, work_dice_path, strategy))
+            std::vector<size_t> failed_edges;
+            bool success = extend_cycle_by_intransitive_dice_insertion_once(dice_cycle, max_num_dice, strategy, num_threads, 0, 0, &failed_edges, statistics);
+            for (int retry_cnt = 0; retry_strategy == RetryStrategy::OPEN_GAPS_AT_FAILED_EDGES && !failed_edges.empty() && dice_cycle.size() < max_num_dice && retry_cnt < max_iterations; retry_cnt++)
             {
-                // New dice found => iterate with extended dice set
-                extended_dice_set = work_dice_set;
-                extended_dice_path = work_dice_path;
-                extended_dice_set.mul_add_values(1, 1 - extended_dice_set.min_die_value()); // normalize min dice value 1
-                if (logger)
-                    logger->cout() << extended_dice_set.print_path_probabilities_x(extended_dice_path, true) << std::endl;
+                // Open gaps between the values of the failed edges only (2, 4, ... like doubling all values), and retry the failed edges only
+                open_value_gaps(dice_cycle, failed_edges, (DieValueT)2 << retry_cnt);
+                std::vector<size_t> retry_edges;
+                retry_edges.swap(failed_edges);
+                success = extend_cycle_by_intransitive_dice_insertion_once(dice_cycle, max_num_dice, strategy, num_threads, 0, &retry_edges, &failed_edges, statistics) || success;
             }
-            else
+            DieValueT retry_factor = 1, retry_offset = 0; // values of a retry: v = retry_factor * v_0 + retry_offset
+            for (int retry_cnt = 0; retry_strategy == RetryStrategy::DOUBLE_ALL_VALUES && !success && retry_cnt < max_iterations; retry_cnt++)
             {
                 // No new dice found => multiply all values of all dice by factor 2 and retry
-                bool success = false;
-                DiceSet input_dice_set = extended_dice_set;
-                DicePath input_dice_path = extended_dice_path;
-                for (int retry_cnt = 0; !success && extended_dice_set.size() < max_num_dice && retry_cnt < max_iterations; retry_cnt++)
-                {
-                    input_dice_set.mul_add_values(2, 0); // enlarge dice values by factor 2 for next round
-                    input_dice_set.mul_add_values(1, 1 - input_dice_set.min_die_value()); // normalize min dice value 1
-                    if (extend_set_by_intransitive_dice_insertion_once(input_dice_set, input_dice_path, max_num_dice, work_dice_set, work_dice_path, strategy))
-                    {
-                        // New dice found => iterate with extended dice set
-                        extended_dice_set = work_dice_set;
-                        extended_dice_path = work_dice_path;
-                        extended_dice_set.mul_add_values(1, 1 - extended_dice_set.min_die_value()); // normalize min dice value 1
-                        success = true;
-                        if (logger)
-                            logger->cout() << extended_dice_set.print_path_probabilities_x(extended_dice_path, true) << std::endl;
-                    }
-                }
-                if (!success)
-                    break;
+                dice_cycle.mul_add_values(2, 0); // enlarge dice values by factor 2 for next round
+                DieValueT offset = 1 - dice_cycle.min_die_value(); // normalize min dice value 1
+                dice_cycle.mul_add_values(1, offset);
+                retry_factor *= 2;
+                retry_offset = 2 * retry_offset + offset;
+                success = extend_cycle_by_intransitive_dice_insertion_once(dice_cycle, max_num_dice, strategy, num_threads, 0, 0, 0, statistics);
             }
+            if (!success)
+            {
+                // All retries failed => restore the values before the retries, i.e. v_0 = (v - retry_offset) / retry_factor
+                for (size_t n = 0; retry_factor > 1 && n < dice_cycle.size(); n++)
+                    for (DieValueT& value : dice_cycle.at(n).values())
+                        value = (value - retry_offset) / retry_factor;
+                break;
+            }
+            // New dice found => iterate with extended dice
+            dice_inserted = true;
+            dice_cycle.mul_add_values(1, 1 - dice_cycle.min_die_value()); // normalize min dice value 1
+            if (logger) // prints a copy of the current dice
+                logger->cout() << DiceSet(extended_dice_name, dice_cycle.dice()).print_path_probabilities_x(dice_cycle.path(), true) << std::endl;
+        }
+        if (!dice_inserted) // no new dice found: return the initial set and path (with normalized values)
+        {
+            extended_dice_set = DiceSet(extended_dice_name, initial_dice_set.dice());
+            if (min_die_value < 1)
+                extended_dice_set.mul_add_values(1, 1 - min_die_value);
+            extended_dice_path = initial_dice_path;
+            return false;
         }
+        extended_dice_path = dice_cycle.path();
+        extended_dice_set = DiceSet(extended_dice_name, dice_cycle.release_dice());
         bool success = extended_dice_set.size() > initial_dice_set.size() && extended_dice_path.size() > initial_dice_path.size();
         return success;
     }
 
     // Insert new dice D_j between D_i and D_(i+1), such that P(D_i > D_j) > 0.5 and P(D_j > D_(i+1)) > 0.5, 
     // once with all dice in the dice set, until the given max. number of dice are reached, or no new dice D_j can be found.
-    // If initial_dice_path is intransitive, extended_dice_path will also be intransitive
-    bool extend_set_by_intransitive_dice_insertion_once(DiceSet& initial_dice_set, DicePath& initial_dice_path, size_t max_num_dice, DiceSet& extended_dice_set, DicePath& extended_dice_path, FindDieStrategy strategy)
+    // If initial_dice_path is intransitive, extended_dice_path will also be intransitive.
+    bool extend_set_by_intransitive_dice_insertion_once(DiceSet& initial_dice_set, DicePath& initial_dice_path, size_t max_num_dice, DiceSet& extended_dice_set, DicePath& extended_dice_path, FindDieStrategy strategy, size_t num_threads)
     {
         assert(initial_dice_set.size() > 1 && initial_dice_path.size() > 1);
-        if (initial_dice_set.size() >= max_num_dice)
+        DiceCycle dice_cycle(initial_dice_set, initial_dice_path);
+        if (initial_dice_set.size() < max_num_dice && extend_cycle_by_intransitive_dice_insertion_once(dice_cycle, max_num_dice, strategy, num_threads)) // success: new dice found
+        {
+            extended_dice_path = dice_cycle.path();
+            extended_dice_set = DiceSet(initial_dice_set.name(), dice_cycle.release_dice());
+            return true;
+        }
+        else // no success, no dice found
         {
             extended_dice_set = initial_dice_set;
             extended_dice_path = initial_dice_path;
             return false;
         }
-        std::vector<Die> extended_dice_vec;
-        extended_dice_vec.reserve(2 * initial_dice_path.size());
-        for (size_t dice_cnt = 1; dice_cnt < initial_dice_path.size(); dice_cnt++)
+    }
+
+    // Insert new dice D_j between D_n and D_(n+1) of a cycle in place, such that P(D_n > D_j) > 0.5 and P(D_j > D_(n+1)) > 0.5, once for all edges,
+    // until the given max. number of dice are reached, or no new dice D_j can be found. The new dice are searched in parallel in blocks of edges,
+    // and each block is inserted in path order, until max_num_dice is reached. The first block contains all edges required to reach max_num_dice.
+    bool extend_cycle_by_intransitive_dice_insertion_once(DiceCycle& dice_cycle, size_t max_num_dice, FindDieStrategy strategy, size_t num_threads, std::vector<size_t>* inserted_dice_idx,
+        const std::vector<size_t>* edges, std::vector<size_t>* failed_edges, FindDieStatistics* statistics)
+    {
+        assert(dice_cycle.size() > 1);
+        if (failed_edges)
+            failed_edges->clear();
+        if (dice_cycle.size() >= max_num_dice)
+            return false;
+        std::vector<std::pair<size_t, Die>> new_dice; // new_dice[k] = (n, D_j): D_j is inserted between D_n and D_(n+1)
+        std::vector<size_t> failed_dice; // D_n of all edges D_n -> D_(n+1) without new die
+        DiceThreadPool thread_pool(num_threads);
+        std::vector<FindDieStatistics> worker_statistics(statistics ? thread_pool.num_threads() : 0); // statistics of each worker, added after the search
+        for (size_t worker_idx = 0; worker_idx < worker_statistics.size(); worker_idx++)
+            worker_statistics[worker_idx].three_level_sample_interval = statistics->three_level_sample_interval;
+        const size_t chunk_size = 64; // edges per task
+        size_t num_edges = edges ? edges->size() : dice_cycle.num_edges();
+        auto edge = [&](size_t edge_cnt) { return edges ? (*edges)[edge_cnt] : edge_cnt; }; // index n of the edge_cnt.th edge D_n -> D_(n+1)
+        size_t block_size = std::max<size_t>(max_num_dice - dice_cycle.size(), 4 * chunk_size * thread_pool.num_threads()); // each edge inserts at most one die
+        bool max_num_dice_reached = false;
+        for (size_t block_begin = 0; block_begin < num_edges && !max_num_dice_reached; block_begin += block_size)
         {
-            int dice_from = initial_dice_path.at(dice_cnt - 1);
-            int dice_to = initial_dice_path.at(dice_cnt);
-            Die die_i = initial_dice_set.at(dice_from);
-            Die die_k = initial_dice_set.at(dice_to);
-            Die die_j = DiceGenerator::find_die_between_two_others(die_i, die_k, strategy);
-            extended_dice_vec.push_back(die_i);
-            if (die_j.num_values() == die_i.num_values()) // success: P(D_i > D_j) > 0.5 and P(D_j > D_(i+1)) > 0.5 => Insert new die_j
-                extended_dice_vec.push_back(die_j);
-            if (extended_dice_vec.size() + ((int)initial_dice_path.size() - (int)dice_cnt) >= max_num_dice) // max number of dice reached => just copy the remaining dice and finish
+            // find_die_between_two_others sorts the values of D_n and D_(n+1). Sort the dice of the block first, so that neighbouring edges
+            // can share their dice without copies while the new dice of all edges of the block are searched in parallel.
+            size_t block_end = std::min(num_edges, block_begin + block_size);
+            size_t num_tasks = (block_end - block_begin + chunk_size - 1) / chunk_size;
+            thread_pool.run(num_tasks, [&](size_t chunk_idx, size_t /*worker_idx*/)
+                {
+                    for (size_t edge_cnt = block_begin + chunk_idx * chunk_size; edge_cnt < std::min(block_end, block_begin + (chunk_idx + 1) * chunk_size); edge_cnt++)
+                        dice_cycle.at(edge(edge_cnt)).sort_values();
+                });
+            for (size_t edge_cnt = block_begin; edge_cnt < block_end; edge_cnt++) // D_(n+1) is already sorted, if it starts another edge of the block
+                dice_cycle.at((edge(edge_cnt) + 1) % dice_cycle.size()).sort_values();
+            std::vector<Die> block_dice(block_end - block_begin);
+            thread_pool.run(num_tasks, [&](size_t chunk_idx, size_t worker_idx)
+                {
+                    for (size_t edge_cnt = block_begin + chunk_idx * chunk_size; edge_cnt < std::min(block_end, block_begin + (chunk_idx + 1) * chunk_size); edge_cnt++)
+                    {
+                        size_t n = edge(edge_cnt);
+                        block_dice[edge_cnt - block_begin] = DiceGenerator::find_die_between_two_others(dice_cycle.at(n), dice_cycle.at((n + 1) % dice_cycle.size()), strategy,
+                            statistics ? &worker_statistics[worker_idx] : 0);
+                    }
+                });
+            // Collect the new dice in path order
+            for (size_t edge_cnt = block_begin; edge_cnt < block_end; edge_cnt++)
             {
-                for (size_t n = dice_cnt + 1; n < initial_dice_path.size(); n++)
-                    extended_dice_vec.push_back(initial_dice_set.at(initial_dice_path.at(n - 1)));
-                break;
+                size_t n = edge(edge_cnt);
+                if (block_dice[edge_cnt - block_begin].num_values() == dice_cycle.at(n).num_values()) // success: P(D_n > D_j) > 0.5 and P(D_j > D_(n+1)) > 0.5 => Insert new die D_j
+                    new_dice.push_back(std::make_pair(n, std::move(block_dice[edge_cnt - block_begin])));
+                else
+                    failed_dice.push_back(n);
+                if (dice_cycle.path_size() + new_dice.size() >= max_num_dice) // max number of dice reached => keep the remaining dice and finish
+                {
+                    max_num_dice_reached = true;
+                    break;
+                }
             }
         }
-        if (extended_dice_vec.size() > initial_dice_set.size()) // success: new dice found
+        for (size_t worker_idx = 0; worker_idx < worker_statistics.size(); worker_idx++)
+            statistics->add(worker_statistics[worker_idx]);
+        if (failed_edges) // index of D_n after insertion: n + number of dice inserted before D_n
         {
-            extended_dice_set = DiceSet(initial_dice_set.name(), extended_dice_vec);
-            std::vector<int> extended_dice_idx;
-            extended_dice_idx.reserve(extended_dice_set.size());
-            for (size_t dice_cnt = 0; dice_cnt < extended_dice_set.size(); dice_cnt++)
-                extended_dice_idx.push_back(dice_cnt);
-            if (initial_dice_path.front() == initial_dice_path.back())
-                extended_dice_idx.push_back(extended_dice_idx.front());
-            extended_dice_path = DicePath(extended_dice_idx);
-            return true;
+            for (size_t k = 0, inserted_cnt = 0; k < failed_dice.size(); k++)
+            {
+                for (; inserted_cnt < new_dice.size() && new_dice[inserted_cnt].first < failed_dice[k]; inserted_cnt++) {}
+                failed_edges->push_back(failed_dice[k] + inserted_cnt);
+            }
         }
-        else // no success, no dice found
-        {
-            extended_dice_set = initial_dice_set;
-            extended_dice_path = initial_dice_path;
+        if (new_dice.empty()) // no success, no dice found
             return false;
+        if (inserted_dice_idx)
+        {
+            inserted_dice_idx->clear();
+            for (size_t k = 0; k < new_dice.size(); k++)
+                inserted_dice_idx->push_back(new_dice[k].first + k + 1);
+        }
+        dice_cycle.splice(new_dice);
+        return true;
+    }
+
+    // Opens gaps of at least min_gap between the distinct values of the dice of the given edges D_n -> D_(n+1) of a cycle. All values of all dice are replaced
+    // by a strictly increasing map v -> v + offset(v), where offset(v) is the sum of the added gaps below v, i.e. all comparisons between all dice are kept.
+    void open_value_gaps(DiceCycle& dice_cycle, const std::vector<size_t>& edges, DieValueT min_gap)
+    {
+        std::vector<DieValueT> values;
+        for (size_t edge_cnt = 0; edge_cnt < edges.size(); edge_cnt++)
+        {
+            const std::vector<DieValueT>& values_i = dice_cycle.at(edges[edge_cnt]).values();
+            const std::vector<DieValueT>& values_k = dice_cycle.at((edges[edge_cnt] + 1) % dice_cycle.size()).values();
+            values.insert(values.end(), values_i.begin(), values_i.end());
+            values.insert(values.end(), values_k.begin(), values_k.end());
         }
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        std::vector<std::pair<DieValueT, DieValueT>> gaps; // gaps[k] = (v, offset): offset(v) = offset for all gaps[k].first <= v < gaps[k+1].first
+        DieValueT offset = 0;
+        for (size_t n = 1; n < values.size(); n++)
+        {
+            if (values[n] - values[n - 1] < min_gap)
+            {
+                offset += min_gap - (values[n] - values[n - 1]);
+                gaps.push_back(std::make_pair(values[n], offset));
+            }
+        }
+        if (gaps.empty())
+            return;
+        dice_cycle.transform_values([&gaps](DieValueT value)
+            {
+                if (value < gaps.front().first)
+                    return value;
+                auto gap = std::upper_bound(gaps.begin(), gaps.end(), std::make_pair(value, std::numeric_limits<DieValueT>::max())) - 1;
+                return value + gap->second;
+            });
     }
 
 } // namespace DiceGenerator
\ No newline at end of file
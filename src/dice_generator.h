@@ -1,6 +1,7 @@
 // Generator for intransitive dice and pairs of dice
 #pragma once
 #include "dice.h"
+#include "dice_cycle.h"
 #include "dice_logger.h"
 
 // DiceGenerator implements some generators for intransitive dice and tuples of dice
@@ -97,16 +98,56 @@ namespace DiceGenerator
 	enum FindDieStrategy 
 	{ 
 		SIMPLE,                // Simple die finding by find_die_between_two_others_simple(), simple and fast for many dice, but may fail (counter examples exist)
-		THREE_LEVEL_INSERTION  // Default: 3 level insertion by find_die_between_two_others_3_level_insertion
+		THREE_LEVEL_INSERTION, // Default: 3 level insertion by find_die_between_two_others_3_level_insertion
+		ADAPTIVE               // Simple die finding first, and 3 level insertion only if the simple die finding fails, i.e. the dice found by 3 level insertion at almost the speed of SIMPLE
+	};
+
+	// Statistics of find_die_between_two_others, e.g. the fallback rate of the ADAPTIVE strategy and the time saved by trying SIMPLE first
+	struct FindDieStatistics
+	{
+		size_t num_searches = 0;               // number of dice searched
+		size_t num_found = 0;                  // number of dice found
+		size_t num_simple_searches = 0;        // number of calls of find_die_between_two_others_simple
+		size_t num_simple_found = 0;           // number of dice found by find_die_between_two_others_simple
+		size_t num_three_level_searches = 0;   // number of calls of find_die_between_two_others_3_level_insertion, i.e. the fallbacks of ADAPTIVE
+		double simple_seconds = 0;             // time spent in find_die_between_two_others_simple
+		double three_level_seconds = 0;        // time spent in find_die_between_two_others_3_level_insertion
+		size_t three_level_sample_interval = 0;      // if > 0, ADAPTIVE additionally times a 3 level insertion for every n.th die found by SIMPLE (default: off, costs extra searches)
+		size_t num_sampled_three_level_searches = 0; // number of 3 level insertions timed on a sample of the dice found by SIMPLE (results are discarded)
+		double sampled_three_level_seconds = 0;      // time spent in the sampled 3 level insertions, not included in three_level_seconds
+
+		// Adds the statistics of another run, e.g. of another thread
+		void add(const FindDieStatistics& other);
+
+		// Returns the fraction of SIMPLE searches falling back to 3 level insertion
+		double fallback_rate(void) const;
+
+		// Returns true, if 3 level insertions have been sampled on dice found by SIMPLE, i.e. saved_seconds() is available
+		bool has_saved_seconds(void) const { return num_sampled_three_level_searches > 0; }
+
+		// Returns the estimated time saved by trying SIMPLE first, i.e. the average time of the sampled 3 level insertions for each die found by SIMPLE,
+		// minus the time of all SIMPLE searches. Negative, if SIMPLE costs more than it saves. Requires has_saved_seconds(), otherwise 0 is returned.
+		double saved_seconds(void) const;
+
+		// Prints the statistics
+		std::string print(void) const;
+	};
+
+	// Retry of extend_set_by_intransitive_dice_insertion, if new dice could not be found
+	enum RetryStrategy
+	{
+		DOUBLE_ALL_VALUES,        // Default: if no die is found for any edge, multiply all values of all dice by 2 and retry all edges
+		OPEN_GAPS_AT_FAILED_EDGES // Retry only the edges without a new die, after opening gaps between the values of their dice by open_value_gaps
 	};
 
 	// Tries to find a die die_j "between" two dice die_i and die_k with P(die_i>die_j) > 0.5 && P(die_j>die_k) > 0.5.
-	Die find_die_between_two_others(Die& die_i, Die& die_k, FindDieStrategy strategy = FindDieStrategy::THREE_LEVEL_INSERTION);
+	// If statistics are given, the searches and their time are counted.
+	Die find_die_between_two_others(Die& die_i, Die& die_k, FindDieStrategy strategy = FindDieStrategy::THREE_LEVEL_INSERTION, FindDieStatistics* statistics = 0);
 
 	// Searches for a die die_j "between" two dice die_i and die_k with P(die_i>die_j) > 0.5 && P(die_j>die_k) > 0.5.
 	// Let die_i and die_k be two N-sided dice with P(die_i>die_k) > 0.5, where die_i[n] is the n-th value of die_i and
 	// die_k[n] is the n-th value of die_k, with 0 <= n < N for N-sided dice. 
-	// This function uses a 3-level insertion algorithm and assumes P(die_i>die_k) > 0.5.
+	// This function uses a 3-level insertion algorithm and assumes P(die_i>die_k) > 0.5. The candidates are evaluated arithmetically in O(1) each.
 	Die find_die_between_two_others_3_level_insertion(Die& die_i, Die& die_k);
 
 	// Tries to find a die die_j "between" two dice die_i and die_k with P(die_i>die_j) > 0.5 && P(die_j>die_k) > 0.5.
@@ -120,14 +161,31 @@ namespace DiceGenerator
 	// Iteratively insert new dice D_j between D_i and D_(i+1), such that P(D_i > D_j) > 0.5 and P(D_j > D_(i+1)) > 0.5.
 	// Start with a given set of dice and a given intransitive path, and repeat the process until
 	// the given max. number of dice are reached, or no new dice D_j can be found.
-	// If initial_dice_path is intransitive, extended_dice_path will also be intransitive
+	// If initial_dice_path is intransitive, extended_dice_path will also be intransitive. The new dice are searched on num_threads threads (or one thread per core if num_threads is 0).
+	// The dice are extended in place in a DiceCycle, i.e. without copies of the set or path in each round. If new dice could not be found, max_iterations retries
+	// double all values (DOUBLE_ALL_VALUES), or open gaps at the failed edges and retry these edges only (OPEN_GAPS_AT_FAILED_EDGES), see RetryStrategy.
 	bool extend_set_by_intransitive_dice_insertion(const DiceSet& initial_dice_set, const DicePath& initial_dice_path, size_t max_num_dice, DiceSet& extended_dice_set, DicePath& extended_dice_path, 
-		FindDieStrategy strategy = FindDieStrategy::THREE_LEVEL_INSERTION, int max_iterations = 2, DiceLogger* logger = 0);
+		FindDieStrategy strategy = FindDieStrategy::THREE_LEVEL_INSERTION, int max_iterations = 2, DiceLogger* logger = 0, size_t num_threads = 0, RetryStrategy retry_strategy = RetryStrategy::DOUBLE_ALL_VALUES,
+		FindDieStatistics* statistics = 0);
 
 	// Insert new dice D_j between D_i and D_(i+1), such that P(D_i > D_j) > 0.5 and P(D_j > D_(i+1)) > 0.5, 
 	// once with all dice in the dice set, until the given max. number of dice are reached, or no new dice D_j can be found.
-	// If initial_dice_path is intransitive, extended_dice_path will also be intransitive
+	// If initial_dice_path is intransitive, extended_dice_path will also be intransitive. The new dice of all edges D_i -> D_(i+1) are searched independently
+	// on num_threads threads (or one thread per core if num_threads is 0) and inserted in path order, i.e. the result does not depend on the number of threads.
 	bool extend_set_by_intransitive_dice_insertion_once(DiceSet& initial_dice_set, DicePath& initial_dice_path, size_t max_num_dice, DiceSet& extended_dice_set, DicePath& extended_dice_path,
-		FindDieStrategy strategy = FindDieStrategy::THREE_LEVEL_INSERTION);
+		FindDieStrategy strategy = FindDieStrategy::THREE_LEVEL_INSERTION, size_t num_threads = 0);
+
+	// Insert new dice D_j between D_n and D_(n+1) of a cycle in place, such that P(D_n > D_j) > 0.5 and P(D_j > D_(n+1)) > 0.5, once for all edges of the cycle,
+	// until the given max. number of dice are reached, or no new dice D_j can be found. The new dice are searched on num_threads threads (or one thread per core if
+	// num_threads is 0) and moved into the cycle in path order. Optionally returns the indices of the inserted dice in the extended cycle. Returns false, if no die was inserted.
+	// If edges is given, only the edges D_n -> D_(n+1) with n in edges (in ascending order) are extended. If failed_edges is given, it returns the edges without a new die
+	// (with the indices n of the extended cycle). If statistics are given, the searches of all threads are added.
+	bool extend_cycle_by_intransitive_dice_insertion_once(DiceCycle& dice_cycle, size_t max_num_dice, FindDieStrategy strategy = FindDieStrategy::THREE_LEVEL_INSERTION,
+		size_t num_threads = 0, std::vector<size_t>* inserted_dice_idx = 0, const std::vector<size_t>* edges = 0, std::vector<size_t>* failed_edges = 0, FindDieStatistics* statistics = 0);
+
+	// Opens gaps of at least min_gap between the distinct values of the dice of the given edges D_n -> D_(n+1) of a cycle, e.g. to insert new dice between
+	// neighbouring values. All values of all dice are mapped by the same strictly increasing map, i.e. all comparisons between all dice are kept,
+	// but in contrast to doubling all values, the values grow only by the gaps opened.
+	void open_value_gaps(DiceCycle& dice_cycle, const std::vector<size_t>& edges, DieValueT min_gap);
 
 } // namespace DiceGenerator
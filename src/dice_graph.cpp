@@ -0,0 +1,1016 @@
+// Graph algorithms on the beat relation of dice
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <climits>
+#include <mutex>
+#include "dice_graph.h"
+#include "dice_thread_pool.h"
+
+namespace DiceGraph
+{
+    // Returns true, if each vertex has at least one incoming and one outgoing edge, i.e. each die beats at least one die and loses against at least one die.
+    bool has_min_degrees(const BitMatrix& graph)
+    {
+        for (int i = 0; i < (int)graph.size(); i++)
+            if (graph.out_degree(i) == 0)
+                return false;
+        std::vector<size_t> in_degrees = graph.in_degrees();
+        for (size_t i = 0; i < in_degrees.size(); i++)
+            if (in_degrees[i] == 0)
+                return false;
+        return true;
+    }
+
+    // Computes the strongly connected components of a graph by Tarjan's algorithm (iterative, without recursion).
+    // Returns the number of components and sets component_of_vertex[i] to the component index of vertex i.
+    size_t strongly_connected_components(const BitMatrix& graph, std::vector<int>& component_of_vertex)
+    {
+        const int N = (int)graph.size();
+        std::vector<std::vector<int>> successors = graph.create_col_indices_foreach_row();
+        std::vector<int> index(N, -1); // order of discovery of each vertex, or -1 if not yet visited
+        std::vector<int> lowlink(N, 0); // smallest index reachable from a vertex through its dfs subtree and at most one back edge
+        std::vector<size_t> next_successor(N, 0); // position of the next successor to visit, replaces the recursion
+        std::vector<bool> on_stack(N, false);
+        std::vector<int> component_stack, dfs_stack;
+        component_stack.reserve(N);
+        dfs_stack.reserve(N);
+        component_of_vertex.assign(N, -1);
+        int next_index = 0, num_components = 0;
+        for (int root = 0; root < N; root++)
+        {
+            if (index[root] >= 0)
+                continue;
+            index[root] = lowlink[root] = next_index++;
+            component_stack.push_back(root);
+            on_stack[root] = true;
+            dfs_stack.push_back(root);
+            while (!dfs_stack.empty())
+            {
+                int v = dfs_stack.back();
+                if (next_successor[v] < successors[v].size())
+                {
+                    int w = successors[v][next_successor[v]++];
+                    if (index[w] < 0) // descend into w
+                    {
+                        index[w] = lowlink[w] = next_index++;
+                        component_stack.push_back(w);
+                        on_stack[w] = true;
+                        dfs_stack.push_back(w);
+                    }
+                    else if (on_stack[w])
+                    {
+                        lowlink[v] = std::min(lowlink[v], index[w]);
+                    }
+                }
+                else // all successors of v visited, return to the parent of v
+                {
+                    dfs_stack.pop_back();
+                    if (!dfs_stack.empty())
+                        lowlink[dfs_stack.back()] = std::min(lowlink[dfs_stack.back()], lowlink[v]);
+                    if (lowlink[v] == index[v]) // v is the root of a component
+                    {
+                        int w = -1;
+                        do
+                        {
+                            w = component_stack.back();
+                            component_stack.pop_back();
+                            on_stack[w] = false;
+                            component_of_vertex[w] = num_components;
+                        } while (w != v);
+                        num_components++;
+                    }
+                }
+            }
+        }
+        assert(component_stack.empty());
+        return num_components;
+    }
+
+    // Returns true, if all vertices of a graph are in one strongly connected component, i.e. each vertex is reachable from each other vertex.
+    bool is_strongly_connected(const BitMatrix& graph)
+    {
+        std::vector<int> component_of_vertex;
+        return strongly_connected_components(graph, component_of_vertex) == 1;
+    }
+
+    // Computes the transitive closure of a graph. The components of Tarjan's algorithm are numbered in reverse topological order, i.e. all successor
+    // components of component c have smaller indices and are completed before c. The closure row of component c is the union of the successors
+    // of its vertices, the closure rows of their components, and the vertices of c, if c has an edge between its own vertices (i.e. a cycle).
+    ReachabilityIndex::ReachabilityIndex(const BitMatrix& graph) : m_closure(graph.size())
+    {
+        const int N = (int)graph.size();
+        m_num_components = strongly_connected_components(graph, m_component_of_vertex);
+        std::vector<std::vector<int>> vertices_of_component(m_num_components);
+        for (int v = 0; v < N; v++)
+            vertices_of_component[m_component_of_vertex[v]].push_back(v);
+        std::vector<size_t> successor_component_added(m_num_components, SIZE_MAX); // successor_component_added[d] = c, if the closure of component d has been added to component c
+        for (size_t c = 0; c < m_num_components; c++)
+        {
+            const std::vector<int>& vertices = vertices_of_component[c];
+            int representative = vertices[0]; // the closure row of component c is computed in the row of its first vertex
+            bool has_cycle = false;
+            for (size_t n = 0; n < vertices.size(); n++)
+            {
+                m_closure.or_row(representative, graph.row(vertices[n]));
+                const uint64_t* words = graph.row(vertices[n]);
+                for (size_t w = 0; w < graph.words_per_row(); w++)
+                {
+                    for (uint64_t word = words[w]; word != 0; word &= (word - 1))
+                    {
+                        size_t d = (size_t)m_component_of_vertex[w * 64 + lowest_bit_index(word)];
+                        if (d == c)
+                            has_cycle = true;
+                        else if (successor_component_added[d] != c)
+                        {
+                            successor_component_added[d] = c;
+                            m_closure.or_row(representative, m_closure.row(vertices_of_component[d][0]));
+                        }
+                    }
+                }
+            }
+            for (size_t n = 0; has_cycle && n < vertices.size(); n++)
+                m_closure.set(representative, vertices[n]);
+            for (size_t n = 1; n < vertices.size(); n++)
+                m_closure.or_row(vertices[n], m_closure.row(representative));
+        }
+    }
+
+    // Returns the smallest rotation g >= 1 of the vertex indices, which maps the graph to itself, or N, if the graph has no rotation symmetry.
+    // The rotations mapping the graph to itself form a subgroup of Z_N, i.e. g is a divisor of N.
+    int rotation_symmetry(const BitMatrix& graph)
+    {
+        const int N = (int)graph.size();
+        for (int g = 1; g < N; g++)
+        {
+            if (N % g != 0)
+                continue;
+            bool symmetric = true;
+            for (int i = 0; i < N && symmetric; i++)
+                for (int j = 0; j < N && symmetric; j++)
+                    symmetric = (graph.at(i, j) == graph.at((i + g) % N, (j + g) % N));
+            if (symmetric)
+                return g;
+        }
+        return std::max(N, 1);
+    }
+
+    // Returns +1, if the reflection i -> -i (mod N) of the vertex indices maps the graph to itself, or -1, if it maps the graph to its transposed graph, or 0 otherwise.
+    int reflection_symmetry(const BitMatrix& graph)
+    {
+        const int N = (int)graph.size();
+        bool symmetric = true, antisymmetric = true;
+        for (int i = 0; i < N && (symmetric || antisymmetric); i++)
+        {
+            for (int j = 0; j < N; j++)
+            {
+                symmetric = symmetric && (graph.at(i, j) == graph.at((N - i) % N, (N - j) % N));
+                antisymmetric = antisymmetric && (graph.at(i, j) == graph.at((N - j) % N, (N - i) % N));
+            }
+        }
+        return symmetric ? 1 : (antisymmetric ? -1 : 0);
+    }
+
+    // Returns false, if a path (0, v_1, ..., v_n) extended by vertex w cannot be completed to a canonical cycle. Each vertex v_p = 0 (mod g)
+    // starts a member of the orbit with first step d_p (rotation), -d_p (reflection to itself) or d_p-1 (reflection to the transposed graph).
+    bool CycleSymmetry::extension_allowed(const std::vector<int>& path, int w) const
+    {
+        if (path.size() < 2)
+            return true;
+        int u = path.back(), d_0 = step(path[0], path[1]), d = step(u, w);
+        if (u % m_rotation == 0 && (d < d_0 || (m_reflection > 0 && m_size - d < d_0)))
+            return false;
+        return !(m_reflection < 0 && w % m_rotation == 0 && d < d_0);
+    }
+
+    // Returns the n-th step of the member of the orbit given by position p and reflection flag, for a cycle given by its steps
+    int CycleSymmetry::orbit_step(const std::vector<int>& steps, int p, bool reflected, int n) const
+    {
+        if (!reflected)
+            return steps[(p + n) % m_size];
+        if (m_reflection > 0)
+            return (m_size - steps[(p + n) % m_size]) % m_size;
+        return steps[(p + 2 * m_size - 1 - n) % m_size];
+    }
+
+    // Returns the steps of a cycle
+    std::vector<int> CycleSymmetry::cycle_steps(const std::vector<int>& cycle) const
+    {
+        assert(cycle.size() == (size_t)m_size + 1 && cycle.front() == 0 && cycle.back() == 0);
+        std::vector<int> steps(m_size);
+        for (int n = 0; n < m_size; n++)
+            steps[n] = step(cycle[n], cycle[n + 1]);
+        return steps;
+    }
+
+    // Returns true, if a cycle (0, v_1, ..., v_N-1, 0) is the canonical cycle of its orbit, i.e. no member of its orbit has smaller steps
+    bool CycleSymmetry::is_canonical(const std::vector<int>& cycle) const
+    {
+        std::vector<int> steps = cycle_steps(cycle);
+        for (int p = 0; p < m_size; p++)
+        {
+            if (cycle[p] % m_rotation != 0)
+                continue;
+            for (int reflected = 0; reflected <= (m_reflection != 0 ? 1 : 0); reflected++)
+            {
+                int n = 0;
+                while (n < m_size && orbit_step(steps, p, reflected != 0, n) == steps[n])
+                    n++;
+                if (n < m_size && orbit_step(steps, p, reflected != 0, n) < steps[n])
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // Returns all cycles (0, ..., 0) in the orbit of a cycle. Cycles with a symmetry of their own appear once.
+    std::vector<std::vector<int>> CycleSymmetry::orbit(const std::vector<int>& cycle) const
+    {
+        std::vector<int> steps = cycle_steps(cycle);
+        std::vector<std::vector<int>> orbit_steps;
+        for (int p = 0; p < m_size; p++)
+        {
+            if (cycle[p] % m_rotation != 0)
+                continue;
+            for (int reflected = 0; reflected <= (m_reflection != 0 ? 1 : 0); reflected++)
+            {
+                orbit_steps.push_back(std::vector<int>(m_size));
+                for (int n = 0; n < m_size; n++)
+                    orbit_steps.back()[n] = orbit_step(steps, p, reflected != 0, n);
+            }
+        }
+        std::sort(orbit_steps.begin(), orbit_steps.end());
+        orbit_steps.erase(std::unique(orbit_steps.begin(), orbit_steps.end()), orbit_steps.end());
+        std::vector<std::vector<int>> cycles(orbit_steps.size(), std::vector<int>(1, 0));
+        for (size_t orbit_idx = 0; orbit_idx < orbit_steps.size(); orbit_idx++)
+            for (int n = 0; n < m_size; n++)
+                cycles[orbit_idx].push_back((cycles[orbit_idx].back() + orbit_steps[orbit_idx][n]) % m_size);
+        return cycles;
+    }
+
+    // Returns the number of cycles in the orbit of a cycle, i.e. the number of members divided by the number of members identical to the cycle
+    size_t CycleSymmetry::orbit_size(const std::vector<int>& cycle) const
+    {
+        std::vector<int> steps = cycle_steps(cycle);
+        size_t num_members = 0, num_identical = 0;
+        for (int p = 0; p < m_size; p++)
+        {
+            if (cycle[p] % m_rotation != 0)
+                continue;
+            for (int reflected = 0; reflected <= (m_reflection != 0 ? 1 : 0); reflected++)
+            {
+                int n = 0;
+                while (n < m_size && orbit_step(steps, p, reflected != 0, n) == steps[n])
+                    n++;
+                num_members++;
+                num_identical += (n == m_size) ? 1 : 0;
+            }
+        }
+        return num_members / num_identical;
+    }
+
+    // Returns true, if a graph is a tournament, i.e. there is exactly one edge i -> j or j -> i between each pair of vertices i != j
+    bool is_tournament(const BitMatrix& graph)
+    {
+        for (int i = 0; i < (int)graph.size(); i++)
+        {
+            if (graph.at(i, i))
+                return false;
+            for (int j = i + 1; j < (int)graph.size(); j++)
+                if (graph.at(i, j) == graph.at(j, i))
+                    return false;
+        }
+        return true;
+    }
+
+    // Finds a Hamiltonian cycle in a tournament in O(N*N) following the constructive proof of Camion's theorem:
+    // 1. Build a Hamiltonian path p_0, ..., p_N-1 by insertion: each vertex v is inserted between p_i -> v -> p_i+1 (binary search).
+    // 2. The initial cycle is p_0, ..., p_i with the last p_i -> p_0.
+    // 3. A vertex v outside the cycle with an edge from and an edge into the cycle is inserted between consecutive c_t -> v -> c_t+1.
+    // 4. If all remaining vertices are beaten by the whole cycle (set A) or beat the whole cycle (set B), strong connectivity
+    //    guarantees an edge u -> w with u in A and w in B. The cycle c_0, c_1, c_2, ... is replaced by c_0, u, w, c_2, ...,
+    //    and c_1 is inserted again by step 3.
+    bool find_hamiltonian_cycle_in_tournament(const BitMatrix& tournament, std::vector<int>& cycle)
+    {
+        cycle.clear();
+        const int N = (int)tournament.size();
+        if (N < 3)
+            return false;
+        // Step 1: Hamiltonian path by binary insertion
+        std::vector<int> path = { 0 };
+        path.reserve(N);
+        for (int v = 1; v < N; v++)
+        {
+            if (tournament.at(v, path.front()))
+                path.insert(path.begin(), v);
+            else if (tournament.at(path.back(), v))
+                path.push_back(v);
+            else // path.front() -> v and v -> path.back()
+            {
+                size_t lo = 0, hi = path.size() - 1;
+                while (hi - lo > 1)
+                {
+                    size_t mid = (lo + hi) / 2;
+                    if (tournament.at(path[mid], v))
+                        lo = mid;
+                    else
+                        hi = mid;
+                }
+                path.insert(path.begin() + hi, v);
+            }
+        }
+        // Step 2: initial cycle p_0, ..., p_i
+        int last_idx = N - 1;
+        while (last_idx > 0 && !tournament.at(path[last_idx], path[0]))
+            last_idx--;
+        if (last_idx < 2)
+            return false; // p_0 has no predecessor: not strongly connected
+        std::vector<int> hamilton_cycle(path.begin(), path.begin() + last_idx + 1);
+        hamilton_cycle.reserve(N);
+        // Flags of all vertices outside the cycle: an edge from the cycle into the vertex, or from the vertex into the cycle
+        std::vector<bool> on_cycle(N, false), has_edge_from_cycle(N, false), has_edge_into_cycle(N, false), pending(N, false);
+        std::vector<int> insertable; // vertices outside the cycle with edges from and into the cycle
+        auto add_to_cycle_flags = [&](int x)
+        {
+            on_cycle[x] = true;
+            for (int v = 0; v < N; v++)
+            {
+                if (on_cycle[v])
+                    continue;
+                if (tournament.at(x, v))
+                    has_edge_from_cycle[v] = true;
+                else
+                    has_edge_into_cycle[v] = true;
+                if (has_edge_from_cycle[v] && has_edge_into_cycle[v] && !pending[v])
+                {
+                    pending[v] = true;
+                    insertable.push_back(v);
+                }
+            }
+        };
+        for (size_t n = 0; n < hamilton_cycle.size(); n++)
+            on_cycle[hamilton_cycle[n]] = true;
+        for (size_t n = 0; n < hamilton_cycle.size(); n++)
+            add_to_cycle_flags(hamilton_cycle[n]);
+        BitMatrix predecessors = tournament.transpose();
+        std::vector<uint64_t> set_A(predecessors.words_per_row(), 0);
+        while (hamilton_cycle.size() < (size_t)N)
+        {
+            // Step 3: insert all vertices with edges from and into the cycle
+            while (!insertable.empty())
+            {
+                int v = insertable.back();
+                insertable.pop_back();
+                size_t k = hamilton_cycle.size(), t = 0;
+                while (t < k && !(tournament.at(hamilton_cycle[t], v) && tournament.at(v, hamilton_cycle[(t + 1) % k])))
+                    t++;
+                assert(t < k);
+                hamilton_cycle.insert(hamilton_cycle.begin() + t + 1, v);
+                add_to_cycle_flags(v);
+            }
+            if (hamilton_cycle.size() == (size_t)N)
+                break;
+            // Step 4: find an edge u -> w from set A (beaten by all vertices of the cycle) into set B (beating all vertices of the cycle)
+            std::fill(set_A.begin(), set_A.end(), 0);
+            for (int v = 0; v < N; v++)
+                if (!on_cycle[v] && has_edge_from_cycle[v])
+                    set_A[v / 64] |= ((uint64_t)1 << (v % 64));
+            int u = -1, w = -1;
+            for (int v = 0; v < N && u < 0; v++)
+            {
+                if (on_cycle[v] || !has_edge_into_cycle[v])
+                    continue;
+                const uint64_t* words = predecessors.row(v);
+                for (size_t word_idx = 0; word_idx < set_A.size() && u < 0; word_idx++)
+                {
+                    if ((words[word_idx] & set_A[word_idx]) != 0)
+                    {
+                        u = (int)(word_idx * 64) + lowest_bit_index(words[word_idx] & set_A[word_idx]);
+                        w = v;
+                    }
+                }
+            }
+            if (u < 0)
+                return false; // no edge from A into B: not strongly connected
+            int c_1 = hamilton_cycle[1]; // c_0 -> u -> w -> c_2 replaces c_0 -> c_1 -> c_2
+            hamilton_cycle[1] = u;
+            hamilton_cycle.insert(hamilton_cycle.begin() + 2, w);
+            add_to_cycle_flags(u);
+            add_to_cycle_flags(w);
+            on_cycle[c_1] = false; // c_1 has the edges c_0 -> c_1 -> c_2 and is inserted again by step 3
+            has_edge_from_cycle[c_1] = has_edge_into_cycle[c_1] = pending[c_1] = true;
+            insertable.push_back(c_1);
+        }
+        // Rotate the cycle to start at vertex 0 and close it
+        std::rotate(hamilton_cycle.begin(), std::find(hamilton_cycle.begin(), hamilton_cycle.end(), 0), hamilton_cycle.end());
+        hamilton_cycle.push_back(0);
+        cycle.swap(hamilton_cycle);
+        return true;
+    }
+
+    // Returns true, if cycle = (0, v_1, ..., v_N-1, 0) is a Hamiltonian cycle of a graph, i.e. contains all vertices exactly once and all its edges are edges of the graph
+    bool is_hamiltonian_cycle(const BitMatrix& graph, const std::vector<int>& cycle)
+    {
+        const int N = (int)graph.size();
+        if (cycle.size() != (size_t)N + 1 || cycle.front() != 0 || cycle.back() != 0)
+            return false;
+        std::vector<bool> visited(N, false);
+        for (int n = 0; n < N; n++)
+        {
+            if (cycle[n] < 0 || cycle[n] >= N || visited[cycle[n]] || !graph.at(cycle[n], cycle[n + 1]))
+                return false;
+            visited[cycle[n]] = true;
+        }
+        return true;
+    }
+
+    // Single restart of the rotation-extension heuristic: extends a random path v_0, ..., v_k at its end, until it is closed to a Hamiltonian cycle,
+    // or max_steps extensions and rotations have been done, or stop_requested returns true. If the end v_k has no unvisited successor:
+    // - Cycle extension: if v_k -> v_0 closes the path to a cycle, and a vertex v_i of the cycle has an unvisited successor w, the path is
+    //   replaced by v_i+1, ..., v_k, v_0, ..., v_i, w.
+    // - Rotation: if v_k -> v_i+1 and v_i -> v_j for i+1 < j <= k, the path is replaced by v_0, ..., v_i, v_j, ..., v_k, v_i+1, ..., v_j-1 with the new end v_j-1.
+    // Returns true and the cycle (0, v_1, ..., v_N-1, 0), or false, if the restart failed.
+    static bool rotation_extension_restart(const BitMatrix& graph, const std::vector<std::vector<int>>& successors, const std::vector<std::vector<int>>& predecessors,
+        std::mt19937& random_generator, size_t max_steps, const std::function<bool(void)>& stop_requested, std::vector<int>& cycle)
+    {
+        const int N = (int)graph.size();
+        std::vector<int> path, position(N, -1); // position[v] = index of v in path, or -1 if v is unvisited
+        path.reserve(N);
+        path.push_back((int)(random_generator() % N));
+        position[path[0]] = 0;
+        auto set_positions = [&](size_t first_idx) { for (size_t n = first_idx; n < path.size(); n++) position[path[n]] = (int)n; };
+        for (size_t step_cnt = 0; step_cnt < max_steps; step_cnt++)
+        {
+            if ((step_cnt % 1024) == 0 && stop_requested && stop_requested())
+                return false;
+            const int k = (int)path.size() - 1, v_k = path[k];
+            if (path.size() == (size_t)N && graph.at(v_k, path[0])) // closed Hamiltonian cycle
+            {
+                std::rotate(path.begin(), path.begin() + position[0], path.end());
+                path.push_back(0);
+                cycle.swap(path);
+                return true;
+            }
+            // Extension by a random unvisited successor of v_k
+            const std::vector<int>& successors_k = successors[v_k];
+            size_t offset = successors_k.empty() ? 0 : random_generator() % successors_k.size(), n = 0;
+            while (n < successors_k.size() && position[successors_k[(offset + n) % successors_k.size()]] >= 0)
+                n++;
+            if (n < successors_k.size())
+            {
+                path.push_back(successors_k[(offset + n) % successors_k.size()]);
+                position[path.back()] = k + 1;
+                continue;
+            }
+            // Cycle extension by an unvisited vertex w with a predecessor v_i on the path
+            if (path.size() < (size_t)N && graph.at(v_k, path[0]))
+            {
+                int i = -1, w = -1;
+                for (int m = 0, offset_w = (int)(random_generator() % N); m < N && i < 0; m++)
+                {
+                    w = (offset_w + m) % N;
+                    for (size_t p = 0; position[w] < 0 && p < predecessors[w].size() && i < 0; p++)
+                        i = position[predecessors[w][p]];
+                }
+                if (i >= 0)
+                {
+                    std::rotate(path.begin(), path.begin() + i + 1, path.end());
+                    path.push_back(w);
+                    set_positions(0);
+                    continue;
+                }
+            }
+            // Rotation by v_k -> v_i+1 and v_i -> v_j
+            int i = -1, j = -1;
+            for (size_t m = 0; m < successors_k.size() && j < 0; m++)
+            {
+                int a = position[successors_k[(offset + m) % successors_k.size()]]; // a = i+1
+                if (a < 1 || a >= k)
+                    continue;
+                const std::vector<int>& successors_i = successors[path[a - 1]];
+                size_t offset_j = random_generator() % successors_i.size();
+                for (size_t q = 0; q < successors_i.size() && j < 0; q++)
+                {
+                    int b = position[successors_i[(offset_j + q) % successors_i.size()]];
+                    if (b > a && b <= k)
+                    {
+                        i = a - 1;
+                        j = b;
+                    }
+                }
+            }
+            if (j < 0)
+                return false; // no rotation possible, restart
+            std::rotate(path.begin() + i + 1, path.begin() + j, path.end());
+            set_positions(i + 1);
+        }
+        return false;
+    }
+
+    // Finds a Hamiltonian cycle by the randomized rotation-extension heuristic of Posa with num_restarts restarts on num_threads threads.
+    // Restart r uses a random generator seeded with r, and the cycle of the first successful restart is returned.
+    bool find_hamiltonian_cycle_by_rotation_extension(const BitMatrix& graph, std::vector<int>& cycle, size_t num_restarts, size_t num_threads, size_t max_steps)
+    {
+        cycle.clear();
+        const int N = (int)graph.size();
+        if (N < 3 || !has_min_degrees(graph))
+            return false;
+        if (max_steps == 0)
+            max_steps = 64 * (size_t)N + 1024;
+        std::vector<std::vector<int>> successors = graph.create_col_indices_foreach_row();
+        std::vector<std::vector<int>> predecessors = graph.transpose().create_col_indices_foreach_row();
+        std::atomic<size_t> first_restart_found(SIZE_MAX);
+        std::mutex cycle_mutex;
+        DiceThreadPool thread_pool(num_threads);
+        thread_pool.run(num_restarts, [&](size_t restart_idx, size_t /*worker_idx*/)
+            {
+                if (restart_idx > first_restart_found.load())
+                    return;
+                std::mt19937 random_generator((uint32_t)restart_idx);
+                std::vector<int> restart_cycle;
+                if (rotation_extension_restart(graph, successors, predecessors, random_generator, max_steps, [&]() { return restart_idx > first_restart_found.load(); }, restart_cycle))
+                {
+                    std::lock_guard<std::mutex> lock(cycle_mutex);
+                    if (restart_idx < first_restart_found.load())
+                    {
+                        first_restart_found.store(restart_idx);
+                        cycle.swap(restart_cycle);
+                    }
+                }
+            });
+        return !cycle.empty();
+    }
+
+    // Returns the rank of a subset in colexicographic order among all subsets of the same size, i.e. sum of binomial(c_i, i+1)
+    // for the elements c_0 < c_1 < ... of the subset (combinatorial number system).
+    static uint64_t colex_rank(uint64_t subset, const std::vector<std::vector<uint64_t>>& binomial)
+    {
+        uint64_t rank = 0;
+        for (int i = 0; subset != 0; subset &= (subset - 1), i++)
+            rank += binomial[lowest_bit_index(subset)][i + 1];
+        return rank;
+    }
+
+    // Returns the next larger subset with the same number of elements (Gosper's hack), i.e. enumerates all subsets of size k in colexicographic order
+    static inline uint64_t next_subset(uint64_t subset)
+    {
+        uint64_t lowest = subset & (~subset + 1);
+        uint64_t ripple = subset + lowest;
+        return (((ripple ^ subset) >> 2) / lowest) | ripple;
+    }
+
+    // Counts the Hamiltonian cycles of a graph with N <= 64 vertices by the Held-Karp subset dynamic programming in O(2^N*N*N) time.
+    // Vertex 0 is the start of all cycles, vertices 1 to N-1 are mapped to bits 0 to n-1 with n = N-1. paths[k][rank(S)*k + j] is the number of
+    // paths starting at vertex 0, which visit exactly the vertices in subset S of size k and end at the j-th element of S. Each entry is pulled
+    // from the paths of subset S without its last element in layer k-1.
+    bool count_hamiltonian_cycles(const BitMatrix& graph, uint64_t& num_cycles, std::vector<int>* witness, std::mt19937& random_generator, size_t max_memory_bytes)
+    {
+        num_cycles = 0;
+        if (witness)
+            witness->clear();
+        const int N = (int)graph.size();
+        const int n = N - 1;
+        if (N < 2 || N > 64)
+            return false;
+        std::vector<uint64_t> predecessors(n, 0); // predecessors[j] has bit i set, if there is an edge from vertex i+1 to vertex j+1
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                if (graph.at(i + 1, j + 1))
+                    predecessors[j] |= ((uint64_t)1 << i);
+        std::vector<std::vector<uint64_t>> binomial(n + 1, std::vector<uint64_t>(n + 2, 0)); // binomial[m][k] = m! / (k! * (m-k)!), fits into 64 bit for m <= 63
+        for (int m = 0; m <= n; m++)
+        {
+            binomial[m][0] = 1;
+            for (int k = 1; k <= m; k++)
+                binomial[m][k] = binomial[m - 1][k - 1] + (k < m ? binomial[m - 1][k] : 0);
+        }
+        // Check the memory limit: two neighbouring layers for the count, or all layers to sample a witness
+        double max_two_layers = 0, all_layers = 0;
+        for (int k = 1; k <= n; k++)
+        {
+            double layer_size = (double)binomial[n][k] * k * sizeof(uint64_t);
+            max_two_layers = std::max(max_two_layers, layer_size + (double)binomial[n][k - 1] * (k - 1) * sizeof(uint64_t));
+            all_layers += layer_size;
+        }
+        if (max_two_layers > (double)max_memory_bytes)
+            return false;
+        bool keep_all_layers = (witness != 0 && all_layers <= (double)max_memory_bytes);
+        std::vector<std::vector<uint64_t>> paths(n + 1);
+        paths[1].resize(n);
+        for (int j = 0; j < n; j++)
+            paths[1][j] = graph.at(0, j + 1) ? 1 : 0; // subset { j } has rank j
+        int elements[64];
+        uint64_t rank_below[65], rank_above[65];
+        for (int k = 2; k <= n; k++)
+        {
+            const std::vector<uint64_t>& prev_paths = paths[k - 1];
+            std::vector<uint64_t>& next_paths = paths[k];
+            next_paths.assign(binomial[n][k] * k, 0);
+            uint64_t rank = 0;
+            for (uint64_t subset = ((uint64_t)1 << k) - 1; subset < ((uint64_t)1 << n); subset = next_subset(subset), rank++)
+            {
+                int num_elements = 0;
+                for (uint64_t bits = subset; bits != 0; bits &= (bits - 1))
+                    elements[num_elements++] = lowest_bit_index(bits);
+                // rank of subset without element j = rank_below[j] + rank_above[j], since the elements above j move down by one position
+                rank_below[0] = 0;
+                for (int i = 0; i < k; i++)
+                    rank_below[i + 1] = rank_below[i] + binomial[elements[i]][i + 1];
+                rank_above[k - 1] = 0;
+                for (int i = k - 1; i > 0; i--)
+                    rank_above[i - 1] = rank_above[i] + binomial[elements[i]][i];
+                for (int j = 0; j < k; j++)
+                {
+                    const uint64_t* sub_paths = prev_paths.data() + (rank_below[j] + rank_above[j]) * (k - 1);
+                    uint64_t preceding = predecessors[elements[j]];
+                    uint64_t num_paths = 0;
+                    for (int i = 0; i < k; i++)
+                    {
+                        if (i != j && ((preceding >> elements[i]) & 1) != 0)
+                        {
+                            uint64_t cnt = sub_paths[i < j ? i : i - 1];
+                            if (num_paths + cnt < num_paths)
+                                return false; // overflow
+                            num_paths += cnt;
+                        }
+                    }
+                    next_paths[rank * k + j] = num_paths;
+                }
+            }
+            if (!keep_all_layers)
+                std::vector<uint64_t>().swap(paths[k - 1]);
+        }
+        // Close the cycles from the last vertex back to vertex 0
+        const std::vector<uint64_t>& full_paths = paths[n];
+        for (int j = 0; j < n; j++)
+        {
+            if (graph.at(j + 1, 0))
+            {
+                if (num_cycles + full_paths[j] < num_cycles)
+                    return false; // overflow
+                num_cycles += full_paths[j];
+            }
+        }
+        // Sample a witness backwards from the full subset: each predecessor is chosen with probability proportional to its number of paths
+        if (keep_all_layers && num_cycles > 0)
+        {
+            std::vector<int> reverse_cycle = { 0 };
+            uint64_t subset = ((uint64_t)1 << n) - 1;
+            uint64_t choice = std::uniform_int_distribution<uint64_t>(0, num_cycles - 1)(random_generator);
+            int j = 0; // position of the last vertex in subset
+            while (!graph.at(j + 1, 0) || choice >= full_paths[j])
+            {
+                if (graph.at(j + 1, 0))
+                    choice -= full_paths[j];
+                j++;
+            }
+            for (int k = n; k > 1; k--)
+            {
+                int num_elements = 0;
+                for (uint64_t bits = subset; bits != 0; bits &= (bits - 1))
+                    elements[num_elements++] = lowest_bit_index(bits);
+                int element_j = elements[j];
+                reverse_cycle.push_back(element_j + 1);
+                uint64_t sub_subset = subset & ~((uint64_t)1 << element_j);
+                const uint64_t* sub_paths = paths[k - 1].data() + colex_rank(sub_subset, binomial) * (k - 1);
+                uint64_t num_paths = paths[k][colex_rank(subset, binomial) * k + j];
+                choice = std::uniform_int_distribution<uint64_t>(0, num_paths - 1)(random_generator);
+                for (int i = 0; i < k; i++)
+                {
+                    if (i != j && ((predecessors[element_j] >> elements[i]) & 1) != 0)
+                    {
+                        uint64_t cnt = sub_paths[i < j ? i : i - 1];
+                        if (choice < cnt)
+                        {
+                            j = (i < j ? i : i - 1);
+                            break;
+                        }
+                        choice -= cnt;
+                    }
+                }
+                subset = sub_subset;
+            }
+            reverse_cycle.push_back(lowest_bit_index(subset) + 1);
+            reverse_cycle.push_back(0);
+            witness->assign(reverse_cycle.rbegin(), reverse_cycle.rend());
+        }
+        return true;
+    }
+
+    // Returns the strongly connected component of vertex v_0 in the subgraph of all vertices >= v_0, sorted in ascending order (i.e. starting with v_0)
+    static std::vector<int> component_of_min_vertex(const std::vector<std::vector<int>>& successors, int v_0)
+    {
+        const int N = (int)successors.size();
+        BitMatrix subgraph(N - v_0); // vertex v >= v_0 is mapped to v - v_0
+        for (int v = v_0; v < N; v++)
+            for (size_t n = 0; n < successors[v].size(); n++)
+                if (successors[v][n] >= v_0)
+                    subgraph.set(v - v_0, successors[v][n] - v_0);
+        std::vector<int> component_of_vertex;
+        strongly_connected_components(subgraph, component_of_vertex);
+        std::vector<int> component;
+        for (int v = v_0; v < N; v++)
+            if (component_of_vertex[v - v_0] == component_of_vertex[0])
+                component.push_back(v);
+        return component;
+    }
+
+    // Enumerates the simple cycles through the first vertex of a strongly connected component with min_length <= length <= max_length vertices.
+    // The successors are mapped to a compact adjacency array of the component (CSR: successors of vertex v are targets[offsets[v]] to targets[offsets[v+1]-1]).
+    // A vertex w is locked by lock[w] = path length when it was appended. After a backtrack from v, which found a cycle in bl steps, the locks of v and
+    // its blocked predecessors are relaxed to max_length - bl + 1 (Gupta and Suzumura), otherwise v stays blocked by its successors as in Johnson's algorithm.
+    static bool search_cycles_in_component(const std::vector<std::vector<int>>& successors, const std::vector<int>& component, size_t min_length, size_t max_length,
+        const std::function<bool(const std::vector<int>& cycle)>& visit, const std::atomic<bool>& stop_requested)
+    {
+        const int K = (int)component.size();
+        const size_t L = std::min(max_length, component.size());
+        std::vector<int> local_idx(successors.size(), -1);
+        for (int k = 0; k < K; k++)
+            local_idx[component[k]] = k;
+        std::vector<uint32_t> offsets(1, 0);
+        std::vector<int> targets;
+        for (int k = 0; k < K; k++)
+        {
+            for (size_t n = 0; n < successors[component[k]].size(); n++)
+                if (local_idx[successors[component[k]][n]] >= 0)
+                    targets.push_back(local_idx[successors[component[k]][n]]);
+            offsets.push_back((uint32_t)targets.size());
+        }
+        BitMatrix blocked_by(K); // blocked_by(w, v) = 1: v is blocked until w is unlocked
+        std::vector<size_t> lock(K, L), blen(1, L); // blen < L: a cycle has been found from the vertex in the path
+        std::vector<uint32_t> next_target(1, offsets[0]); // position of the next successor to try for each vertex in the path
+        std::vector<bool> on_path(K, false);
+        std::vector<int> path(1, 0), cycle;
+        lock[0] = 0;
+        on_path[0] = true;
+        for (size_t step_cnt = 1; !path.empty(); step_cnt++)
+        {
+            if ((step_cnt % 1024) == 0 && stop_requested.load())
+                return false;
+            int v = path.back();
+            bool extended = false;
+            while (next_target.back() < offsets[v + 1] && !extended)
+            {
+                int w = targets[next_target.back()++];
+                if (w == 0) // cycle found
+                {
+                    if (path.size() >= min_length)
+                    {
+                        cycle.clear();
+                        for (size_t n = 0; n < path.size(); n++)
+                            cycle.push_back(component[path[n]]);
+                        cycle.push_back(component[0]);
+                        if (!visit(cycle))
+                            return false;
+                    }
+                    blen.back() = 1;
+                }
+                else if (path.size() < lock[w])
+                {
+                    lock[w] = path.size();
+                    on_path[w] = true;
+                    path.push_back(w);
+                    next_target.push_back(offsets[w]);
+                    blen.push_back(L);
+                    extended = true;
+                }
+            }
+            if (extended)
+                continue;
+            // Backtrack from v
+            path.pop_back();
+            on_path[v] = false;
+            next_target.pop_back();
+            size_t bl = blen.back();
+            blen.pop_back();
+            if (!blen.empty())
+                blen.back() = std::min(blen.back(), bl);
+            if (bl < L) // cycle found from v in bl steps: relax the locks of v and all vertices blocked by v
+            {
+                std::vector<std::pair<size_t, int>> relax_stack(1, std::make_pair(bl, v));
+                while (!relax_stack.empty())
+                {
+                    std::pair<size_t, int> relax = relax_stack.back();
+                    relax_stack.pop_back();
+                    if (lock[relax.second] < L - relax.first + 1)
+                    {
+                        lock[relax.second] = L - relax.first + 1;
+                        const uint64_t* row = blocked_by.row(relax.second);
+                        for (size_t word_idx = 0; word_idx < blocked_by.words_per_row(); word_idx++)
+                            for (uint64_t bits = row[word_idx]; bits != 0; bits &= (bits - 1))
+                            {
+                                int u = (int)(64 * word_idx) + lowest_bit_index(bits);
+                                if (!on_path[u])
+                                    relax_stack.push_back(std::make_pair(relax.first + 1, u));
+                            }
+                    }
+                }
+            }
+            else // no cycle found from v: v stays locked until one of its successors is relaxed
+            {
+                for (uint32_t pos = offsets[v]; pos < offsets[v + 1]; pos++)
+                    blocked_by.set(targets[pos], v);
+            }
+        }
+        return true;
+    }
+
+    // Enumerates all simple cycles with min_length <= length <= max_length vertices by Johnson's algorithm with the length bounded locks of Gupta and Suzumura.
+    bool enumerate_simple_cycles(const BitMatrix& graph, size_t min_length, size_t max_length, const std::function<bool(const std::vector<int>& cycle)>& visit, size_t num_threads)
+    {
+        const int N = (int)graph.size();
+        min_length = std::max<size_t>(min_length, 2);
+        if (max_length < min_length || N < 2)
+            return true;
+        std::vector<std::vector<int>> successors = graph.create_col_indices_foreach_row();
+        std::mutex visit_mutex;
+        std::atomic<bool> stop_requested(false);
+        DiceThreadPool thread_pool(num_threads);
+        thread_pool.run(N - 1, [&](size_t task_idx, size_t /*worker_idx*/)
+            {
+                if (stop_requested.load())
+                    return;
+                std::vector<int> component = component_of_min_vertex(successors, (int)task_idx);
+                if (component.size() < min_length)
+                    return;
+                search_cycles_in_component(successors, component, min_length, max_length, [&](const std::vector<int>& cycle)
+                    {
+                        std::lock_guard<std::mutex> lock(visit_mutex);
+                        if (stop_requested.load() || !visit(cycle))
+                            stop_requested.store(true);
+                        return !stop_requested.load();
+                    }, stop_requested);
+            });
+        return !stop_requested.load();
+    }
+
+    // Finds a longest simple cycle of a graph by enumerate_simple_cycles, skipping all components, which are too small for a longer cycle.
+    bool find_longest_simple_cycle(const BitMatrix& graph, std::vector<int>& cycle, size_t num_threads)
+    {
+        const int N = (int)graph.size();
+        cycle.clear();
+        std::vector<std::vector<int>> successors = graph.create_col_indices_foreach_row();
+        std::mutex cycle_mutex;
+        std::atomic<size_t> longest_length(0); // number of vertices in the longest cycle found
+        std::atomic<bool> stop_requested(false);
+        DiceThreadPool thread_pool(num_threads);
+        thread_pool.run(std::max(N - 1, 0), [&](size_t task_idx, size_t /*worker_idx*/)
+            {
+                if ((size_t)N - task_idx <= longest_length.load()) // not enough vertices left for a longer cycle
+                    return;
+                std::vector<int> component = component_of_min_vertex(successors, (int)task_idx);
+                if (component.size() < 2 || component.size() <= longest_length.load())
+                    return;
+                search_cycles_in_component(successors, component, longest_length.load() + 1, component.size(), [&](const std::vector<int>& found_cycle)
+                    {
+                        size_t length = found_cycle.size() - 1;
+                        std::lock_guard<std::mutex> lock(cycle_mutex);
+                        if (length > longest_length.load())
+                        {
+                            cycle = found_cycle;
+                            longest_length.store(length);
+                        }
+                        return length < component.size(); // a cycle through all vertices of the component cannot be extended
+                    }, stop_requested);
+            });
+        return !cycle.empty();
+    }
+
+    // Returns true, if a path ending at vertex v can still be completed by edges in graph (and graph_t = transposed graph): v has a successor in the
+    // unvisited vertices, each unvisited vertex has a predecessor in the unvisited vertices or v and a successor in the unvisited vertices or 0,
+    // and 0 has a predecessor in the unvisited vertices (forward check). unvisited is a bitmask of the unvisited vertices.
+    static bool path_can_be_completed(const BitMatrix& graph, const BitMatrix& graph_t, int v, const std::vector<uint64_t>& unvisited)
+    {
+        const size_t num_words = unvisited.size();
+        bool unvisited_empty = true, succ_v = false, pred_0 = false;
+        for (size_t word_idx = 0; word_idx < num_words; word_idx++)
+        {
+            unvisited_empty = unvisited_empty && unvisited[word_idx] == 0;
+            succ_v = succ_v || (graph.row(v)[word_idx] & unvisited[word_idx]) != 0;
+            pred_0 = pred_0 || (graph_t.row(0)[word_idx] & unvisited[word_idx]) != 0;
+        }
+        if (unvisited_empty)
+            return graph.at(v, 0);
+        if (!succ_v || !pred_0)
+            return false;
+        for (size_t word_idx = 0; word_idx < num_words; word_idx++)
+        {
+            for (uint64_t bits = unvisited[word_idx]; bits != 0; bits &= (bits - 1))
+            {
+                int u = (int)(64 * word_idx) + lowest_bit_index(bits);
+                bool succ_u = graph.at(u, 0), pred_u = graph_t.at(u, v);
+                for (size_t n = 0; n < num_words && !(succ_u && pred_u); n++)
+                {
+                    succ_u = succ_u || (graph.row(u)[n] & unvisited[n]) != 0;
+                    pred_u = pred_u || (graph_t.row(u)[n] & unvisited[n]) != 0;
+                }
+                if (!succ_u || !pred_u)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // Finds the Hamiltonian cycle with the largest bottleneck by a depth-first branch and bound. The successors are tried in descending order of their levels,
+    // such that good cycles are found first. Each cycle found raises the bound, i.e. only edges above the bottleneck of the best cycle are kept.
+    // A branch is pruned, if its path contains an edge at or below the bound, or if the path cannot be completed by the remaining edges (forward check).
+    // The search stops, if the bottleneck reaches the upper bound min_v(max. level of the in- and outgoing edges of v).
+    bool find_bottleneck_hamiltonian_cycle(const SqrMatrix<int>& edge_levels, int min_level, std::vector<int>& cycle, int& bottleneck_level)
+    {
+        const int N = (int)edge_levels.size();
+        cycle.clear();
+        bottleneck_level = min_level;
+        if (N < 2)
+            return false;
+        std::vector<std::vector<int>> successors(N); // successors sorted by descending edge level
+        std::vector<int> max_out_level(N, -1), max_in_level(N, -1);
+        for (int i = 0; i < N; i++)
+        {
+            for (int j = 0; j < N; j++)
+            {
+                if (i != j && edge_levels.at(i, j) > min_level)
+                {
+                    successors[i].push_back(j);
+                    max_out_level[i] = std::max(max_out_level[i], edge_levels.at(i, j));
+                    max_in_level[j] = std::max(max_in_level[j], edge_levels.at(i, j));
+                }
+            }
+            std::stable_sort(successors[i].begin(), successors[i].end(), [&](int a, int b) { return edge_levels.at(i, a) > edge_levels.at(i, b); });
+        }
+        int upper_bound_level = INT_MAX;
+        for (int v = 0; v < N; v++)
+            upper_bound_level = std::min(upper_bound_level, std::min(max_out_level[v], max_in_level[v]));
+        BitMatrix graph(N), graph_t(N); // all edges above the bound
+        auto keep_edges_above_bound = [&]()
+        {
+            graph = BitMatrix(N);
+            graph_t = BitMatrix(N);
+            for (int i = 0; i < N; i++)
+                for (size_t n = 0; n < successors[i].size() && edge_levels.at(i, successors[i][n]) > bottleneck_level; n++)
+                {
+                    graph.set(i, successors[i][n]);
+                    graph_t.set(successors[i][n], i);
+                }
+        };
+        keep_edges_above_bound();
+        std::vector<uint64_t> unvisited((N + 63) / 64, 0);
+        for (int v = 1; v < N; v++)
+            unvisited[v / 64] |= ((uint64_t)1 << (v % 64));
+        std::vector<int> path(1, 0), path_bottleneck(1, INT_MAX); // path_bottleneck[n] = min. level of the first n edges of the path
+        std::vector<size_t> next_candidate(1, 0); // next_candidate[n] is the position of the next successor of path[n] to try
+        if (upper_bound_level <= min_level || !path_can_be_completed(graph, graph_t, 0, unvisited))
+            return false;
+        while (!path.empty() && bottleneck_level < upper_bound_level)
+        {
+            int v = path.back();
+            bool extended = false;
+            if (path_bottleneck.back() > bottleneck_level)
+            {
+                if (path.size() == (size_t)N) // all vertices visited: close the cycle and raise the bound
+                {
+                    if (edge_levels.at(v, 0) > bottleneck_level)
+                    {
+                        bottleneck_level = std::min(path_bottleneck.back(), edge_levels.at(v, 0));
+                        cycle = path;
+                        cycle.push_back(0);
+                        keep_edges_above_bound();
+                    }
+                }
+                else
+                {
+                    while (next_candidate.back() < successors[v].size() && !extended)
+                    {
+                        int w = successors[v][next_candidate.back()++];
+                        int level = edge_levels.at(v, w);
+                        if (level <= bottleneck_level) // all remaining successors are at or below the bound
+                            next_candidate.back() = successors[v].size();
+                        else if ((unvisited[w / 64] >> (w % 64)) & 1)
+                        {
+                            unvisited[w / 64] &= ~((uint64_t)1 << (w % 64));
+                            if (path_can_be_completed(graph, graph_t, w, unvisited))
+                            {
+                                int bottleneck = std::min(path_bottleneck.back(), level);
+                                path.push_back(w);
+                                path_bottleneck.push_back(bottleneck);
+                                next_candidate.push_back(0);
+                                extended = true;
+                            }
+                            else
+                                unvisited[w / 64] |= ((uint64_t)1 << (w % 64));
+                        }
+                    }
+                }
+            }
+            if (!extended) // backtrack
+            {
+                if (path.size() > 1)
+                    unvisited[v / 64] |= ((uint64_t)1 << (v % 64));
+                path.pop_back();
+                path_bottleneck.pop_back();
+                next_candidate.pop_back();
+            }
+        }
+        return !cycle.empty();
+    }
+
+} // namespace DiceGraph
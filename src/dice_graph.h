@@ -0,0 +1,154 @@
+// Graph algorithms on the beat relation of dice
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+#include "dice_matrix.h"
+
+// DiceGraph implements graph algorithms on directed graphs given by a BitMatrix, e.g. the beat matrix of a set of dice
+// with an edge i -> j, if P(D_i>D_j) > 0.5. An intransitive chain of all dice is a closed cycle through all vertices of this graph.
+namespace DiceGraph
+{
+    // Returns true, if each vertex has at least one incoming and one outgoing edge, i.e. each die beats at least one die and loses against at least one die.
+    // Otherwise no closed cycle can contain all vertices.
+    bool has_min_degrees(const BitMatrix& graph);
+
+    // Computes the strongly connected components of a graph by Tarjan's algorithm (iterative, without recursion).
+    // Returns the number of components and sets component_of_vertex[i] to the component index of vertex i.
+    // Components are numbered in the order they are completed, i.e. in reverse topological order of the condensed graph.
+    size_t strongly_connected_components(const BitMatrix& graph, std::vector<int>& component_of_vertex);
+
+    // Returns true, if all vertices of a graph are in one strongly connected component, i.e. each vertex is reachable from each other vertex.
+    // Otherwise no closed cycle can contain all vertices.
+    bool is_strongly_connected(const BitMatrix& graph);
+
+    // ReachabilityIndex stores the transitive closure of a graph as a bit matrix, i.e. closure(i,j) = 1, if there is a path of at least one edge
+    // from vertex i to vertex j, e.g. if die D_i beats die D_j via a chain of beats. The closure is computed on the condensation of the strongly
+    // connected components in reverse topological order, where the rows of all successor components are combined word by word in O(N*N*N/64)
+    // time in the worst case. Reachability, same component and cycle queries take O(1).
+    class ReachabilityIndex
+    {
+    public:
+
+        // Computes the transitive closure of a graph
+        ReachabilityIndex(const BitMatrix& graph = BitMatrix());
+
+        // Returns true, if vertex j is reachable from vertex i by a path of at least one edge
+        bool can_reach(int i, int j) const { return m_closure.at(i, j); }
+
+        // Returns true, if vertex i and vertex j are in the same strongly connected component, i.e. if a cycle contains both vertices
+        bool same_component(int i, int j) const { return m_component_of_vertex[i] == m_component_of_vertex[j]; }
+
+        // Returns true, if vertex i is part of a cycle, i.e. if vertex i is reachable from itself
+        bool on_cycle(int i) const { return m_closure.at(i, i); }
+
+        // Returns the strongly connected component of vertex i
+        int component(int i) const { return m_component_of_vertex[i]; }
+
+        // Returns the number of strongly connected components
+        size_t num_components(void) const { return m_num_components; }
+
+        // Returns the transitive closure
+        const BitMatrix& closure(void) const { return m_closure; }
+
+    protected:
+
+        BitMatrix m_closure; // m_closure(i,j) = 1, if vertex j is reachable from vertex i
+        std::vector<int> m_component_of_vertex; // strongly connected component of each vertex
+        size_t m_num_components = 0; // number of strongly connected components
+    };
+
+    // Returns the smallest rotation g >= 1 of the vertex indices, which maps the graph to itself, i.e. graph(i,j) = graph(i+g,j+g) (mod N) for all i,j,
+    // e.g. g = 1 for a circulant graph. All multiples of g are rotations of the graph, too. Returns N, if the graph has no rotation symmetry.
+    int rotation_symmetry(const BitMatrix& graph);
+
+    // Returns +1, if the reflection i -> -i (mod N) of the vertex indices maps the graph to itself, or -1, if it maps the graph to its transposed graph
+    // (i.e. it maps cycles to reversed cycles, e.g. for a circulant tournament), or 0 otherwise.
+    int reflection_symmetry(const BitMatrix& graph);
+
+    // CycleSymmetry describes the orbits of the Hamiltonian cycles of a graph under its symmetries, i.e. the rotations by multiples of g and
+    // the reflection of the vertex indices, which map the graph to itself. A cycle (v_0 = 0, v_1, ..., v_N-1, 0) is represented by its steps
+    // d_p = v_p+1 - v_p (mod N). Rotating vertex v_p to 0 (if v_p = 0 mod g) gives the cycle with steps d_p, d_p+1, ..., and the reflection gives
+    // the negated steps -d_p, -d_p+1, ... (graph mapped to itself) resp. the reversed steps d_p-1, d_p-2, ... (graph mapped to its transposed graph).
+    // The canonical cycle of an orbit is the cycle with the lexicographically smallest steps, i.e. its first step d_0 is its smallest step.
+    class CycleSymmetry
+    {
+    public:
+
+        // Detects the symmetries of a graph
+        CycleSymmetry(const BitMatrix& graph) : m_size((int)graph.size()), m_rotation(rotation_symmetry(graph)), m_reflection(reflection_symmetry(graph)) {}
+
+        // Returns true, if the graph has a symmetry except the identity
+        bool has_symmetry(void) const { return m_size >= 3 && (m_rotation < m_size || m_reflection != 0); }
+
+        // Returns false, if a path (0, v_1, ..., v_n) extended by vertex w cannot be completed to a canonical cycle, i.e. if a step is smaller than d_0
+        bool extension_allowed(const std::vector<int>& path, int w) const;
+
+        // Returns true, if a cycle (0, v_1, ..., v_N-1, 0) is the canonical cycle of its orbit
+        bool is_canonical(const std::vector<int>& cycle) const;
+
+        // Returns all cycles (0, ..., 0) in the orbit of a cycle
+        std::vector<std::vector<int>> orbit(const std::vector<int>& cycle) const;
+
+        // Returns the number of cycles in the orbit of a cycle
+        size_t orbit_size(const std::vector<int>& cycle) const;
+
+    protected:
+
+        // Returns the step from vertex u to vertex v
+        int step(int u, int v) const { return (m_size + v - u) % m_size; }
+
+        // Returns the n-th step of the member of the orbit given by position p and reflection flag, for a cycle given by its steps
+        int orbit_step(const std::vector<int>& steps, int p, bool reflected, int n) const;
+
+        // Returns the steps of a cycle
+        std::vector<int> cycle_steps(const std::vector<int>& cycle) const;
+
+        int m_size = 0; // number of vertices N
+        int m_rotation = 1; // rotations by multiples of m_rotation map the graph to itself
+        int m_reflection = 0; // +1: reflection maps the graph to itself, -1: reflection maps the graph to its transposed graph, 0: no reflection symmetry
+    };
+
+    // Returns true, if a graph is a tournament, i.e. there is exactly one edge i -> j or j -> i between each pair of vertices i != j
+    bool is_tournament(const BitMatrix& graph);
+
+    // Finds a Hamiltonian cycle in a tournament in O(N*N) (Camion's theorem: a tournament has a Hamiltonian cycle, if and only if it is strongly connected).
+    // Returns true and the cycle (0, v_1, ..., v_N-1, 0), if the tournament is strongly connected and N >= 3, or false otherwise.
+    bool find_hamiltonian_cycle_in_tournament(const BitMatrix& tournament, std::vector<int>& cycle);
+
+    // Returns true, if cycle = (0, v_1, ..., v_N-1, 0) is a Hamiltonian cycle of a graph, i.e. contains all vertices exactly once and all its edges are edges of the graph
+    bool is_hamiltonian_cycle(const BitMatrix& graph, const std::vector<int>& cycle);
+
+    // Finds a Hamiltonian cycle in large graphs (e.g. thousands of vertices) by the randomized rotation-extension heuristic of Posa for directed graphs:
+    // a path is extended by unvisited successors of its end, and if there are none, the end is changed by rotations of the path, or a closed
+    // cycle is broken up to extend it by an unvisited vertex. Each of num_restarts restarts begins with a random vertex and stops after max_steps
+    // (or 64*N+1024 if max_steps is 0). The restarts run on num_threads threads (or one thread per core if num_threads is 0), and the cycle
+    // of the successful restart with the smallest index is returned, i.e. the result does not depend on the number of threads.
+    // Returns true and the cycle (0, v_1, ..., v_N-1, 0), or false, if all restarts failed (which does not prove, that there is no Hamiltonian cycle).
+    bool find_hamiltonian_cycle_by_rotation_extension(const BitMatrix& graph, std::vector<int>& cycle, size_t num_restarts = 16, size_t num_threads = 1, size_t max_steps = 0);
+
+    // Counts the Hamiltonian cycles of a graph with N <= 64 vertices, i.e. the closed cycles starting at vertex 0, which contain all vertices exactly once,
+    // by the Held-Karp subset dynamic programming in O(2^N*N*N) time without enumerating the cycles. The subsets are processed layer by layer
+    // in order of their size, and only two layers are kept in memory, i.e. at most max_memory_bytes are allocated.
+    // If witness is given and all layers fit into max_memory_bytes, one cycle is sampled uniformly at random and returned as (0, v_1, ..., v_N-1, 0).
+    // Returns false, if the number of cycles exceeds 64 bit or the memory required exceeds max_memory_bytes, or true otherwise.
+    bool count_hamiltonian_cycles(const BitMatrix& graph, uint64_t& num_cycles, std::vector<int>* witness, std::mt19937& random_generator, size_t max_memory_bytes);
+
+    // Enumerates all simple cycles with min_length <= length <= max_length vertices, i.e. also cycles through a subset of the vertices, by Johnson's algorithm
+    // with the length bounded locks of Gupta and Suzumura in O((c+1)*L*(N+E)) time for c cycles of max. length L. Each cycle is visited as (v_0, ..., v_0)
+    // starting at its smallest vertex, grouped by v_0 in ascending order. The search for each v_0 runs in the strongly connected component of v_0
+    // in the subgraph of all vertices >= v_0. These searches are independent and run on num_threads threads (or one thread per core if num_threads is 0),
+    // then the cycles are visited one at a time in order of completion. Returns false, if visit returned false and stopped the enumeration, or true otherwise.
+    bool enumerate_simple_cycles(const BitMatrix& graph, size_t min_length, size_t max_length, const std::function<bool(const std::vector<int>& cycle)>& visit, size_t num_threads = 1);
+
+    // Finds a longest simple cycle of a graph by enumerate_simple_cycles, skipping all components, which are too small for a longer cycle.
+    // Returns true and the cycle (v_0, ..., v_0) starting at its smallest vertex, or false, if the graph has no cycle.
+    bool find_longest_simple_cycle(const BitMatrix& graph, std::vector<int>& cycle, size_t num_threads = 1);
+
+    // Finds the Hamiltonian cycle with the largest bottleneck, i.e. the largest minimum level of all its edges, by branch and bound.
+    // edge_levels(i,j) >= 0 is the level (i.e. the rank of the weight) of the edge i -> j, or -1 if there is no edge. Only cycles with a bottleneck > min_level are searched.
+    // Returns true and the cycle (0, v_1, ..., v_N-1, 0) with its bottleneck level, or false, if there is no Hamiltonian cycle with a bottleneck > min_level.
+    bool find_bottleneck_hamiltonian_cycle(const SqrMatrix<int>& edge_levels, int min_level, std::vector<int>& cycle, int& bottleneck_level);
+
+} // namespace DiceGraph
@@ -1,8 +1,16 @@
 // Matrices for dice
 #pragma once
+#include <algorithm>
+#include <array>
+#include <assert.h>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
+#include "dice_util.h"
 
 // NxN-matrix stored in a flat memory model
 template <typename MatType> class SqrMatrix
@@ -40,6 +48,46 @@ public:
     return m_stride; 
   }
 
+  // Inserts rows and columns at the given indices of the enlarged matrix (sorted in ascending order), e.g. { N } appends a row and a column.
+  // The values are moved in place from back to front without a temporary matrix. The new rows and columns are set to initial_value.
+  void insert(const std::vector<size_t>& new_indices, MatType initial_value = 0)
+  {
+    const size_t old_N = m_stride, N = m_stride + new_indices.size();
+    std::vector<size_t> moved_idx(old_N); // index of each old row and column in the enlarged matrix
+    for (size_t n = 0, old_n = 0, new_cnt = 0; n < N; n++)
+    {
+      if (new_cnt < new_indices.size() && new_indices[new_cnt] == n)
+        new_cnt++;
+      else
+        moved_idx[old_n++] = n;
+    }
+    m_matrix.resize(N * N, initial_value);
+    for (size_t old_j = old_N; old_j-- > 0; ) // each value moves to an index >= its old index, i.e. moving back to front overwrites moved values only
+      for (size_t old_i = old_N; old_i-- > 0; )
+        m_matrix[moved_idx[old_j] * N + moved_idx[old_i]] = m_matrix[old_j * old_N + old_i];
+    m_stride = N;
+    for (size_t new_cnt = 0; new_cnt < new_indices.size(); new_cnt++)
+    {
+      for (size_t n = 0; n < N; n++)
+      {
+        at((int)new_indices[new_cnt], (int)n) = initial_value;
+        at((int)n, (int)new_indices[new_cnt]) = initial_value;
+      }
+    }
+  }
+
+  // Removes the row and column idx. The values are moved in place from front to back without a temporary matrix.
+  void remove(size_t idx)
+  {
+    assert(idx < m_stride);
+    const size_t old_N = m_stride, N = m_stride - 1;
+    for (size_t j = 0; j < N; j++) // each value moves to an index <= its old index, i.e. moving front to back overwrites moved values only
+      for (size_t i = 0; i < N; i++)
+        m_matrix[j * N + i] = m_matrix[(j < idx ? j : j + 1) * old_N + (i < idx ? i : i + 1)];
+    m_matrix.resize(N * N);
+    m_stride = N;
+  }
+
   // Returns a list of column indices for each row, which have a value > 0.
   // Example: std::vector<std::vector<int>> col_indices_per_row = create_col_indices_foreach_row()
   // Then n = col_indices_per_row[i][0] is the first dice with P(D_i > D_n) > 0.5 (if it exists, i.e.  col_indices_per_row[i].size() > 0).
@@ -78,3 +126,322 @@ protected:
   size_t m_stride = 0; // i.e. N
 };
 
+
+// Returns the index of the lowest set bit in a non-zero word
+inline int lowest_bit_index(uint64_t word)
+{
+  assert(word != 0);
+#if defined(_MSC_VER)
+  unsigned long bit_index = 0;
+  _BitScanForward64(&bit_index, word);
+  return (int)bit_index;
+#else
+  return __builtin_ctzll(word);
+#endif
+}
+
+// NxN-matrix of bits stored row by row in 64-bit words, e.g. the adjacency matrix of the beat relation with at(i,j) = true, if P(D_i>D_j) > 0.5.
+// Compared to SqrMatrix<int>, a row of N dice takes N/64 words and can be scanned word by word.
+class BitMatrix
+{
+public:
+
+  BitMatrix(size_t N = 0) : m_size(N), m_words_per_row((N + 63) / 64), m_bits(N * ((N + 63) / 64), 0)
+  {
+  }
+
+  inline bool at(int i, int j) const
+  {
+    assert(i >= 0 && i < (int)m_size && j >= 0 && j < (int)m_size);
+    return ((m_bits[i * m_words_per_row + j / 64] >> (j % 64)) & 1) != 0;
+  }
+
+  inline void set(int i, int j, bool value = true)
+  {
+    assert(i >= 0 && i < (int)m_size && j >= 0 && j < (int)m_size);
+    uint64_t& word = m_bits[i * m_words_per_row + j / 64];
+    if (value)
+      word |= ((uint64_t)1 << (j % 64));
+    else
+      word &= ~((uint64_t)1 << (j % 64));
+  }
+
+  // Returns the words of row i, i.e. bit j of row(i)[j / 64] is set, if at(i,j) is true
+  inline const uint64_t* row(int i) const
+  {
+    return m_bits.data() + i * m_words_per_row;
+  }
+
+  inline uint64_t* row(int i)
+  {
+    return m_bits.data() + i * m_words_per_row;
+  }
+
+  // Sets all bits of a given row in row i, i.e. row(i) |= words
+  inline void or_row(int i, const uint64_t* words)
+  {
+    uint64_t* row_words = row(i);
+    for (size_t w = 0; w < m_words_per_row; w++)
+      row_words[w] |= words[w];
+  }
+
+  inline size_t words_per_row(void) const
+  {
+    return m_words_per_row;
+  }
+
+  inline size_t size(void) const
+  {
+    return m_size;
+  }
+
+  // Returns the number of bits set in row i, i.e. the number of dice beaten by D_i in a beat matrix
+  size_t out_degree(int i) const
+  {
+    size_t degree = 0;
+    const uint64_t* words = row(i);
+    for (size_t w = 0; w < m_words_per_row; w++)
+      degree += std::bitset<64>(words[w]).count();
+    return degree;
+  }
+
+  // Returns the number of bits set in each column, i.e. the number of dice beating D_j in a beat matrix
+  std::vector<size_t> in_degrees(void) const
+  {
+    std::vector<size_t> degrees(m_size, 0);
+    for (int i = 0; i < (int)m_size; i++)
+    {
+      const uint64_t* words = row(i);
+      for (size_t w = 0; w < m_words_per_row; w++)
+        for (uint64_t word = words[w]; word != 0; word &= (word - 1))
+          degrees[w * 64 + lowest_bit_index(word)]++;
+    }
+    return degrees;
+  }
+
+  // Returns the transposed matrix, i.e. row j of the transposed beat matrix contains all dice beating D_j
+  BitMatrix transpose(void) const
+  {
+    BitMatrix transposed(m_size);
+    for (int i = 0; i < (int)m_size; i++)
+    {
+      const uint64_t* words = row(i);
+      for (size_t w = 0; w < m_words_per_row; w++)
+        for (uint64_t word = words[w]; word != 0; word &= (word - 1))
+          transposed.set((int)(w * 64) + lowest_bit_index(word), i);
+    }
+    return transposed;
+  }
+
+  // Returns a list of column indices for each row, which have a bit set, see SqrMatrix::create_col_indices_foreach_row.
+  std::vector<std::vector<int>> create_col_indices_foreach_row(void) const
+  {
+    std::vector<std::vector<int>> indices_per_row(m_size);
+    for (int i = 0; i < (int)m_size; i++)
+    {
+      indices_per_row[i].reserve(out_degree(i));
+      const uint64_t* words = row(i);
+      for (size_t w = 0; w < m_words_per_row; w++)
+        for (uint64_t word = words[w]; word != 0; word &= (word - 1))
+          indices_per_row[i].push_back((int)(w * 64) + lowest_bit_index(word));
+    }
+    return indices_per_row;
+  }
+
+  // Formats the bits of this matrix into a string
+  std::string print(void) const
+  {
+    std::stringstream str;
+    for (int i = 0; i < (int)m_size; i++)
+    {
+      for (int j = 0; j < (int)m_size; j++)
+        str << " " << (at(i, j) ? 1 : 0);
+      str << std::endl;
+    }
+    return str.str();
+  }
+
+protected:
+
+  size_t m_size = 0; // i.e. N
+  size_t m_words_per_row = 0; // i.e. (N + 63) / 64
+  std::vector<uint64_t> m_bits; // row-major bits, row i starts at m_bits[i * m_words_per_row]
+};
+
+// BeatMatrix stores the exact number of outcomes, in which die D_i beats die D_j, for all pairs of dice in a set.
+// wins(i,j) is the number of (D_i > D_j) outcomes, losses(i,j) = wins(j,i) is the number of (D_j > D_i) outcomes,
+// and P(D_i > D_j) = wins(i,j) / num_outcomes(i,j) with num_outcomes(i,j) = num_values(D_i) * num_values(D_j).
+class BeatMatrix
+{
+public:
+
+  BeatMatrix() {}
+
+  // Counts wins and losses of all pairs of dice. The pairs (i,j) with i <= j are split into tiles of tile_size x tile_size pairs,
+  // which are processed in parallel by num_threads threads (or by all hardware threads, if num_threads is 0).
+  // Note: DieType::count_beats must be thread-safe, and the dice values should be sorted for a fast merge (see Die::sort_values).
+  template <typename DieType> void compute(const std::vector<DieType>& dice, size_t num_threads = 0, size_t tile_size = 32)
+  {
+    size_t N = dice.size();
+    m_wins = SqrMatrix<size_t>(N, 0);
+    m_num_values.resize(N);
+    for (size_t n = 0; n < N; n++)
+    {
+      m_num_values[n] = dice[n].num_values();
+      assert(m_num_values[n] <= DiceUtil::MAX_NUM_VALUES); // num_outcomes must not overflow
+    }
+    size_t num_tile_rows = (N + tile_size - 1) / tile_size;
+    std::vector<std::array<size_t, 2>> tiles; // (row tile, col tile) with row tile <= col tile
+    tiles.reserve(num_tile_rows * (num_tile_rows + 1) / 2);
+    for (size_t tile_i = 0; tile_i < num_tile_rows; tile_i++)
+      for (size_t tile_j = tile_i; tile_j < num_tile_rows; tile_j++)
+        tiles.push_back({ tile_i, tile_j });
+    std::atomic<size_t> next_tile(0);
+    std::atomic<bool> lose_is_transposed_beat(true);
+    auto compute_tiles = [&]()
+    {
+      for (size_t tile_idx = next_tile++; tile_idx < tiles.size(); tile_idx = next_tile++)
+      {
+        size_t i_end = std::min(N, (tiles[tile_idx][0] + 1) * tile_size), j_end = std::min(N, (tiles[tile_idx][1] + 1) * tile_size);
+        for (size_t i = tiles[tile_idx][0] * tile_size; i < i_end; i++)
+          for (size_t j = std::max(i, tiles[tile_idx][1] * tile_size); j < j_end; j++)
+          {
+            std::array<size_t, 2> beats = dice[i].count_beats(dice[j]);
+            m_wins.at((int)i, (int)j) = beats[0];
+            m_wins.at((int)j, (int)i) = beats[1];
+            if (i != j && !pair_lose_is_transposed_beat((int)i, (int)j))
+              lose_is_transposed_beat = false;
+          }
+      }
+    };
+    if (num_threads == 0)
+      num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    num_threads = std::min(num_threads, tiles.size());
+    std::vector<std::thread> threads;
+    for (size_t n = 1; n < num_threads; n++)
+      threads.push_back(std::thread(compute_tiles));
+    compute_tiles();
+    for (size_t n = 0; n < threads.size(); n++)
+      threads[n].join();
+    m_lose_is_transposed_beat = lose_is_transposed_beat;
+    m_valid = true;
+  }
+
+  // Inserts the rows and columns of new dice dice[new_indices[k]] into the valid win counts of all other dice, i.e. counts only the K*N pairs
+  // of K new dice instead of all N*N pairs, and moves the old counts once in place. dice must contain all dice including the new dice,
+  // and new_indices are their indices in dice in ascending order (e.g. { N-1 } to append a die).
+  template <typename DieType> void insert(const std::vector<DieType>& dice, const std::vector<size_t>& new_indices)
+  {
+    assert(m_valid && dice.size() == size() + new_indices.size() && std::is_sorted(new_indices.begin(), new_indices.end()));
+    const size_t N = dice.size();
+    m_wins.insert(new_indices, 0);
+    std::vector<bool> is_new_die(N, false);
+    for (size_t new_cnt = 0; new_cnt < new_indices.size(); new_cnt++)
+    {
+      size_t idx = new_indices[new_cnt];
+      assert(idx < N && !is_new_die[idx]);
+      is_new_die[idx] = true;
+      m_num_values.insert(m_num_values.begin() + idx, dice[idx].num_values());
+      assert(m_num_values[idx] <= DiceUtil::MAX_NUM_VALUES); // num_outcomes must not overflow
+    }
+    for (size_t new_cnt = 0; new_cnt < new_indices.size(); new_cnt++)
+    {
+      size_t idx = new_indices[new_cnt];
+      for (size_t j = 0; j < N; j++)
+      {
+        if (is_new_die[j] && j < idx) // pair of two new dice, counted with die j
+          continue;
+        std::array<size_t, 2> beats = dice[idx].count_beats(dice[j]);
+        m_wins.at((int)idx, (int)j) = beats[0];
+        m_wins.at((int)j, (int)idx) = beats[1];
+        if (j != idx && !pair_lose_is_transposed_beat((int)idx, (int)j))
+          m_lose_is_transposed_beat = false;
+      }
+    }
+  }
+
+  // Inserts the row and column of a new die dice[idx], see insert(dice, new_indices)
+  template <typename DieType> void insert(const std::vector<DieType>& dice, size_t idx) { insert(dice, std::vector<size_t>{ idx }); }
+
+  // Removes the row and column of die idx from the valid win counts. The counts are moved in place.
+  void remove(size_t idx)
+  {
+    assert(m_valid && idx < size());
+    const size_t N = size() - 1;
+    m_wins.remove(idx);
+    m_num_values.erase(m_num_values.begin() + idx);
+    m_lose_is_transposed_beat = true; // the removed die may have been the only one with a tie
+    for (int i = 0; i < (int)N && m_lose_is_transposed_beat; i++)
+      for (int j = i + 1; j < (int)N && m_lose_is_transposed_beat; j++)
+        m_lose_is_transposed_beat = pair_lose_is_transposed_beat(i, j);
+  }
+
+  // Returns true, if the win counts have been computed and are still valid
+  inline bool valid(void) const { return m_valid; }
+
+  // Invalidates the win counts, e.g. after the dice have been changed
+  void clear(void)
+  {
+    m_wins = SqrMatrix<size_t>();
+    m_num_values.clear();
+    m_lose_is_transposed_beat = false;
+    m_valid = false;
+  }
+
+  // Returns the number of dice
+  inline size_t size(void) const { return m_wins.size(); }
+
+  // Returns true, if the lose matrix is the transposed beat matrix, i.e. P(D_i>D_j) < 0.5 if and only if P(D_j>D_i) > 0.5 for all pairs of dice.
+  // Then each lose cycle is a reversed beat cycle. Detected by compute, e.g. true for all sets without ties.
+  inline bool lose_is_transposed_beat(void) const { return m_lose_is_transposed_beat; }
+
+  // Returns the number of outcomes with D_i > D_j
+  inline size_t wins(int i, int j) const { return m_wins.at(i, j); }
+
+  // Returns the number of outcomes with D_j > D_i
+  inline size_t losses(int i, int j) const { return m_wins.at(j, i); }
+
+  // Returns the number of all outcomes of rolling D_i and D_j
+  inline size_t num_outcomes(int i, int j) const { return m_num_values[i] * m_num_values[j]; }
+
+  // Returns P(D_i > D_j)
+  inline double probability(int i, int j) const { return (double)wins(i, j) / (double)num_outcomes(i, j); }
+
+  // Returns true, if P(D_i > D_j) > 0.5, i.e. wins > num_outcomes - wins (without overflow of 2 * wins)
+  inline bool beats(int i, int j) const { return wins(i, j) > num_outcomes(i, j) - wins(i, j); }
+
+  // Returns true, if P(D_i > D_j) < 0.5, i.e. wins < num_outcomes - wins (without overflow of 2 * wins)
+  inline bool loses(int i, int j) const { return wins(i, j) < num_outcomes(i, j) - wins(i, j); }
+
+  // Returns a NxN-bitmatrix with matrix(i,j) = 1, if P(D_i>D_j) > 0.5 and i != j, or 0 otherwise
+  BitMatrix create_beat_matrix(void) const
+  {
+    BitMatrix matrix(size());
+    for (int i = 0; i < (int)size(); i++)
+      for (int j = 0; j < (int)size(); j++)
+        if (i != j && beats(i, j))
+          matrix.set(i, j);
+    return matrix;
+  }
+
+  // Returns a NxN-bitmatrix with matrix(i,j) = 1, if P(D_i>D_j) < 0.5 and i != j, or 0 otherwise
+  BitMatrix create_lose_matrix(void) const
+  {
+    BitMatrix matrix(size());
+    for (int i = 0; i < (int)size(); i++)
+      for (int j = 0; j < (int)size(); j++)
+        if (i != j && loses(i, j))
+          matrix.set(i, j);
+    return matrix;
+  }
+
+protected:
+
+  // Returns true, if P(D_i>D_j) < 0.5 and P(D_j>D_i) > 0.5 are equivalent (and vice versa)
+  inline bool pair_lose_is_transposed_beat(int i, int j) const { return loses(i, j) == beats(j, i) && loses(j, i) == beats(i, j); }
+
+  SqrMatrix<size_t> m_wins; // m_wins(i,j) = number of outcomes with D_i > D_j
+  std::vector<size_t> m_num_values; // number of values (sides) of each die
+  bool m_lose_is_transposed_beat = false; // true, if P(D_i>D_j) < 0.5 and P(D_j>D_i) > 0.5 are equivalent for all pairs of dice
+  bool m_valid = false; // becomes true after the win counts have been computed
+};
@@ -1,36 +1,76 @@
 // Supporting classes for closed paths and cycles of (possibly intransitive) dice
 #pragma once
+#include <algorithm>
+#include <assert.h>
+#include <bitset>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <functional>
 #include <list>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "dice_util.h"
 
-// DicePath stores a single path, i.e. a list of dice indices
+// DicePath stores a single path, i.e. a list of dice indices.
+// Paths of up to INLINE_CAPACITY dice are stored inline without heap allocation. The dice in a path are marked in a bitmask,
+// which is updated on each append, such that is_in_list and contains_all_dices take O(1).
 class DicePath
 {
 public:
 
+  static constexpr size_t INLINE_CAPACITY = 24; // max. number of dice stored inline, i.e. cycles of up to 23 dice
+
   DicePath() {}
 
   DicePath(const std::vector<int>& start_indices)
   {
-    m_dice_indices = start_indices;
+    for (size_t n = 0; n < start_indices.size(); n++)
+      append(start_indices[n]);
   }
 
-  const int& front()
+  const int& front() const
   {
-    return m_dice_indices.front();
+    assert(m_size > 0);
+    return data()[0];
   }
 
-  const int& back()
+  const int& back() const
   {
-    return m_dice_indices.back();
+    assert(m_size > 0);
+    return data()[m_size - 1];
   }
 
   void append(int index)
   {
-    m_dice_indices.push_back(index);
+    assert(index >= 0);
+    if (m_size < INLINE_CAPACITY)
+    {
+      m_inline_indices[m_size] = index;
+    }
+    else
+    {
+      if (m_size == INLINE_CAPACITY) // move to heap
+        m_heap_indices.assign(m_inline_indices, m_inline_indices + INLINE_CAPACITY);
+      m_heap_indices.push_back(index);
+    }
+    m_size++;
+    if (!is_in_list(index))
+    {
+      if (index < 64)
+      {
+        m_dice_mask |= ((uint64_t)1 << index);
+      }
+      else
+      {
+        if (m_heap_dice_mask.size() < (size_t)index / 64)
+          m_heap_dice_mask.resize(index / 64, 0);
+        m_heap_dice_mask[index / 64 - 1] |= ((uint64_t)1 << (index % 64));
+      }
+      m_num_dice++;
+    }
   }
 
   bool append_if_not_in_list(int index)
@@ -44,65 +84,71 @@ public:
   }
 
   // Returns true, if this path contains a given dice, or false otherwise
-  bool is_in_list(int index)
+  bool is_in_list(int index) const
   {
-    for (size_t n = 0; n < m_dice_indices.size(); n++)
-    {
-      if (m_dice_indices[n] == index)
-        return true;
-    }
-    return false;
+    if (index < 64)
+      return ((m_dice_mask >> index) & 1) != 0;
+    return (size_t)index / 64 <= m_heap_dice_mask.size() && ((m_heap_dice_mask[index / 64 - 1] >> (index % 64)) & 1) != 0;
   }
 
   // Returns true, if two paths contain identical dice, or false otherwise
   bool is_identical(const DicePath& path) const
   {
-    if (m_dice_indices.size() == path.m_dice_indices.size())
-      return std::equal(m_dice_indices.begin(), m_dice_indices.end(), path.m_dice_indices.begin());
+    if (m_size == path.m_size)
+      return std::equal(data(), data() + m_size, path.data());
     return false;
   }
 
-  // Returns true, if this paths contains all dice (i.e. from 0 up to num_dices-1), or false otherwise
-  bool contains_all_dices(size_t num_dices)
+  // Returns true, if this paths contains all dice (i.e. from 0 up to num_dices-1), or false otherwise.
+  // All dice indices in this path must be smaller than num_dices.
+  bool contains_all_dices(size_t num_dices) const
   {
-    std::vector<int> side_range(num_dices, 0);
-    for (size_t n = 0; n < m_dice_indices.size(); n++)
-      side_range[m_dice_indices[n]] = 1;
-    for (size_t n = 0; n < num_dices; n++)
-      if (side_range[n] == 0)
-        return false;
-    return true;
+    return m_num_dice == num_dices;
   }
 
   // Returns the number of dice in this path
   size_t size(void) const
   {
-    return m_dice_indices.size();
+    return m_size;
   }
 
   // Returns the n-th die in this path
   int at(size_t n) const
   {
-    assert(n >= 0 && n < m_dice_indices.size());
-    return m_dice_indices[n];
+    assert(n >= 0 && n < m_size);
+    return data()[n];
+  }
+
+  // Returns the dice in this path
+  const int* data(void) const
+  {
+    return (m_size <= INLINE_CAPACITY) ? m_inline_indices : m_heap_indices.data();
   }
 
   // Formats the dice in this path into a string
   std::string print(void) const
   {
     std::stringstream str;
-    for (std::vector<int>::const_iterator dice_iter = m_dice_indices.cbegin(); dice_iter != m_dice_indices.cend(); dice_iter++)
-      str << (dice_iter != m_dice_indices.cbegin() ? " " : "") << *dice_iter;
+    for (size_t n = 0; n < m_size; n++)
+      str << (n > 0 ? " " : "") << data()[n];
     return str.str();
   }
 
-  // Formats the dice in this path into an decimal number
+  // Formats the dice in this path into an decimal number, e.g. 1 12 4 for path (0 11 3).
+  // Numbers exceeding LLONG_MAX are saturated to LLONG_MAX.
   size_t to_decimal(void) const
   {
-    std::stringstream str;
-    for (size_t n = 0; n < m_dice_indices.size(); n++)
-      str << (m_dice_indices[n] + 1);
-    return atoll(str.str().c_str());
+    unsigned long long decimal = 0;
+    for (size_t n = 0; n < m_size; n++)
+    {
+      unsigned long long digits = (unsigned long long)data()[n] + 1, scale = 10;
+      while (scale <= digits)
+        scale *= 10;
+      if (decimal > (LLONG_MAX - digits) / scale)
+        return (size_t)LLONG_MAX;
+      decimal = decimal * scale + digits;
+    }
+    return (size_t)decimal;
   }
 
   // Returns a bonus message, if the path converted to decimal number is a prime or a palindrome
@@ -122,16 +168,75 @@ public:
     return bonus.str();
   }
 
+  // Returns the canonical form of a closed cycle (D_i, ..., D_i), i.e. its lexicographically smallest rotation, e.g. (0 2 1 0) for (2 1 0 2).
+  // If mirror_equivalent is true, the smaller of the canonical forms of the cycle and the reversed cycle is returned, such that a beat cycle
+  // and its mirror image, the lose cycle through the same dice in opposite direction, have the same canonical form. Open paths are returned unchanged.
+  DicePath canonical_cycle(bool mirror_equivalent = false) const
+  {
+    if (m_size < 2 || front() != back())
+      return *this;
+    const int* dice = data();
+    const size_t len = m_size - 1; // number of dice in the cycle, the last die closes the cycle
+    const int min_die = *std::min_element(dice, dice + len);
+    size_t best_start = 0; // the smallest rotation starts with the smallest die
+    int best_direction = 0; // +1: rotation of the cycle, -1: rotation of the reversed cycle
+    for (int direction = 1; direction >= (mirror_equivalent ? -1 : 1); direction -= 2)
+    {
+      for (size_t start = 0; start < len; start++)
+      {
+        if (dice[start] != min_die)
+          continue;
+        int cmp = (best_direction == 0) ? -1 : 0;
+        for (size_t n = 0; n < len && cmp == 0; n++)
+        {
+          int die = dice[(start + len + direction * n) % len], best_die = dice[(best_start + len + best_direction * n) % len];
+          cmp = (die < best_die) ? -1 : ((die > best_die) ? 1 : 0);
+        }
+        if (cmp < 0)
+        {
+          best_start = start;
+          best_direction = direction;
+        }
+      }
+    }
+    DicePath cycle;
+    for (size_t n = 0; n <= len; n++)
+      cycle.append(dice[(best_start + len + best_direction * n) % len]);
+    return cycle;
+  }
+
+  // Returns a hash value of the dice in this path (FNV-1a)
+  size_t hash(void) const
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t n = 0; n < m_size; n++)
+      hash = (hash ^ (uint64_t)(uint32_t)data()[n]) * 1099511628211ULL;
+    return (size_t)hash;
+  }
+
+  bool operator==(const DicePath& path) const { return is_identical(path); }
+
+  // Hash function for unordered containers of paths
+  struct Hash
+  {
+    size_t operator()(const DicePath& path) const { return path.hash(); }
+  };
+
 protected:
-  std::vector<int> m_dice_indices; // list of dice representing the path
+  size_t m_size = 0; // number of dice in this path
+  int m_inline_indices[INLINE_CAPACITY]; // list of dice representing the path, if m_size <= INLINE_CAPACITY
+  std::vector<int> m_heap_indices; // list of dice representing the path, if m_size > INLINE_CAPACITY
+  uint64_t m_dice_mask = 0; // bit i is set, if die D_i with i < 64 is in this path
+  std::vector<uint64_t> m_heap_dice_mask; // bit i of m_heap_dice_mask[w] is set, if die D_(64*(w+1)+i) is in this path
+  size_t m_num_dice = 0; // number of different dice in this path
 };
 
-// DicePathList stores a list of dice paths
-class DicePathList
+// DiceOpenPathList stores a list of open (i.e. incomplete) paths, which are extended in place by the recursive search of closed cycles
+class DiceOpenPathList
 {
 public:
 
-  DicePathList() { }
+  DiceOpenPathList() { }
 
   DicePath& front(void) { return m_paths.front(); }
 
@@ -143,12 +248,11 @@ public:
 
   void append(const DicePath& path) { m_paths.push_back(path); }
 
-  void append(DicePathList& path) { m_paths.insert(m_paths.end(), path.m_paths.begin(), path.m_paths.end()); }
-
-  void splice(DicePathList& path) { m_paths.splice(m_paths.end(), path.m_paths); }
-
   size_t size(void) const { return m_paths.size(); }
 
+  // Returns the approx. number of bytes allocated for all paths (list nodes with inline dice)
+  size_t memory_bytes(void) const { return m_paths.size() * (sizeof(DicePath) + 2 * sizeof(void*)); }
+
   std::list<DicePath>::iterator begin() { return m_paths.begin(); }
 
   std::list<DicePath>::const_iterator cbegin() const { return m_paths.cbegin(); }
@@ -174,40 +278,323 @@ public:
     }
   }
 
-  // Remove all duplicated paths
-  void remove_duplicate_paths(void)
+  // Formats the list of all paths into a string
+  std::string print(int max_paths_to_print = INT_MAX) const
   {
-    for (std::list<DicePath>::iterator path_iter1 = m_paths.begin(); path_iter1 != m_paths.end(); path_iter1++)
+    int path_cnt = 0;
+    std::stringstream str;
+    str << "[ ";
+    for (std::list<DicePath>::const_iterator path_iter = m_paths.cbegin(); path_iter != m_paths.cend() && path_cnt < max_paths_to_print; path_iter++, path_cnt++)
     {
-      std::list<DicePath>::iterator path_iter2 = path_iter1;
-      for (path_iter2++; path_iter2 != m_paths.end(); )
+      if (path_iter != m_paths.cbegin())
+        str << ", ";
+      str << "(" << path_iter->print() << ")";
+    }
+    if (path_cnt < m_paths.size())
+      str << ", ... ";
+    str << " ]";
+    return str.str();
+  }
+
+protected:
+  std::list<DicePath> m_paths; // list of paths
+};
+
+// Optional removal of duplicated cycles in a DicePathList
+enum CycleDeduplication
+{
+  NO_DEDUPLICATION,             // Default: all paths are appended
+  CANONICAL_ROTATION,           // cycles are dropped, if a rotation of the cycle has already been appended, e.g. (1 0 2 1) after (0 2 1 0)
+  CANONICAL_ROTATION_AND_MIRROR // cycles are dropped, if a rotation of the cycle or of the reversed cycle has already been appended, e.g. (0 1 2 0) after (0 2 1 0)
+};
+
+// DicePathList stores a list of dice paths in a prefix tree: each path shares the nodes of its common prefix with the previously appended path.
+// Paths found by a depth-first search differ in their last dice only, so millions of paths take a few nodes per path instead of a heap allocation per path.
+// Paths are appended and iterated, but not changed. Iterators return paths materialized from the prefix tree.
+// Optionally, the hash of the canonical form of each appended cycle is stored in a hash map, and duplicated cycles are dropped in O(1) on append.
+class DicePathList
+{
+public:
+
+  // Iterator over all paths in a DicePathList. Each path is materialized on dereference.
+  class const_iterator
+  {
+  public:
+
+    const_iterator(const DicePathList* list = 0, size_t path_idx = 0) : m_list(list), m_path_idx(path_idx) {}
+
+    const DicePath& operator*() const
+    {
+      if (m_materialized_idx != m_path_idx)
       {
-        if (path_iter2->is_identical(*path_iter1))
-          path_iter2 = m_paths.erase(path_iter2);
-        else
-          path_iter2++;
+        m_path = m_list->at(m_path_idx);
+        m_materialized_idx = m_path_idx;
       }
+      return m_path;
+    }
+
+    const DicePath* operator->() const { return &(operator*()); }
+
+    const_iterator& operator++() { m_path_idx++; return *this; }
+
+    const_iterator operator++(int) { const_iterator iter = *this; m_path_idx++; return iter; }
+
+    bool operator==(const const_iterator& other) const { return m_list == other.m_list && m_path_idx == other.m_path_idx; }
+
+    bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+  protected:
+    const DicePathList* m_list = 0;
+    size_t m_path_idx = 0; // index of the current path
+    mutable DicePath m_path; // current path materialized from the prefix tree
+    mutable size_t m_materialized_idx = SIZE_MAX; // index of the path in m_path
+  };
+
+  DicePathList(CycleDeduplication deduplication = NO_DEDUPLICATION) : m_deduplication(deduplication) { }
+
+  DicePath front(void) const { return at(0); }
+
+  DicePath back(void) const { return at(size() - 1); }
+
+  // Appends a path, which shares the nodes of the common prefix with the last appended path.
+  // Returns false, if the path is a duplicate of an already appended cycle and has been dropped, or true otherwise.
+  bool append(const DicePath& path)
+  {
+    if (m_deduplication != NO_DEDUPLICATION && is_duplicate_cycle(path))
+      return false;
+    size_t prefix_len = 0;
+    while (prefix_len < path.size() && prefix_len < m_last_path_nodes.size() && m_nodes[m_last_path_nodes[prefix_len]].die_idx == path.at(prefix_len))
+      prefix_len++;
+    m_last_path_nodes.resize(prefix_len);
+    for (size_t n = prefix_len; n < path.size(); n++)
+    {
+      m_nodes.push_back(Node{ path.at(n), (n > 0) ? m_last_path_nodes[n - 1] : NO_NODE });
+      m_last_path_nodes.push_back((uint32_t)(m_nodes.size() - 1));
     }
+    m_leaves.push_back(path.size() > 0 ? m_last_path_nodes.back() : NO_NODE);
+    return true;
+  }
+
+  // Appends all paths of another list
+  void append(const DicePathList& paths)
+  {
+    for (const_iterator path_iter = paths.cbegin(); path_iter != paths.cend(); path_iter++)
+      append(*path_iter);
+  }
+
+  // Moves all paths of another list to the end of this list
+  void splice(DicePathList& paths)
+  {
+    if (size() == 0 && m_deduplication == paths.m_deduplication)
+      std::swap(*this, paths);
+    else
+      append(paths);
+    paths = DicePathList(paths.m_deduplication);
+  }
+
+  size_t size(void) const { return m_leaves.size(); }
+
+  // Returns the n-th path in this list, materialized from the prefix tree
+  DicePath at(size_t n) const
+  {
+    assert(n < m_leaves.size());
+    std::vector<int> reverse_path;
+    for (uint32_t node_idx = m_leaves[n]; node_idx != NO_NODE; node_idx = m_nodes[node_idx].parent)
+      reverse_path.push_back(m_nodes[node_idx].die_idx);
+    std::reverse(reverse_path.begin(), reverse_path.end());
+    return DicePath(reverse_path);
+  }
+
+  const_iterator cbegin() const { return const_iterator(this, 0); }
+
+  const_iterator cend() const { return const_iterator(this, size()); }
+
+  const_iterator begin() const { return cbegin(); }
+
+  const_iterator end() const { return cend(); }
+
+  // Returns the number of nodes in the prefix tree, i.e. the number of dice stored for all paths
+  size_t num_nodes(void) const { return m_nodes.size(); }
+
+  // Returns the approx. number of bytes allocated for the prefix tree and the hashes of the canonical cycles
+  size_t memory_bytes(void) const
+  {
+    return m_nodes.capacity() * sizeof(Node) + (m_leaves.capacity() + m_last_path_nodes.capacity()) * sizeof(uint32_t)
+      + m_canonical_cycles.size() * (sizeof(std::pair<const uint64_t, uint32_t>) + 2 * sizeof(void*)) + m_canonical_cycles.bucket_count() * sizeof(void*);
+  }
+
+  // Returns the removal of duplicated cycles on append
+  CycleDeduplication deduplication(void) const { return m_deduplication; }
+
+  // Removes all duplicated paths in O(number of dice) per path, i.e. identical paths and cycles with identical canonical form
+  // (optionally including mirror images). Subsequently appended duplicates are dropped, too.
+  void remove_duplicate_paths(bool mirror_equivalent = false)
+  {
+    DicePathList unique_paths(mirror_equivalent ? CANONICAL_ROTATION_AND_MIRROR : CANONICAL_ROTATION);
+    for (const_iterator path_iter = cbegin(); path_iter != cend(); path_iter++)
+      unique_paths.append(*path_iter);
+    std::swap(*this, unique_paths);
   }
 
   // Formats the list of all paths into a string
   std::string print(int max_paths_to_print = INT_MAX) const
   {
-    int path_cnt = 0;
+    size_t path_cnt = 0;
     std::stringstream str;
     str << "[ ";
-    for (std::list<DicePath>::const_iterator path_iter = m_paths.cbegin(); path_iter != m_paths.cend() && path_cnt < max_paths_to_print; path_iter++, path_cnt++)
+    for (const_iterator path_iter = cbegin(); path_iter != cend() && path_cnt < (size_t)std::max(0, max_paths_to_print); path_iter++, path_cnt++)
     {
-      if (path_iter != m_paths.cbegin())
+      if (path_iter != cbegin())
         str << ", ";
       str << "(" << path_iter->print() << ")";
     }
-    if (path_cnt < m_paths.size())
+    if (path_cnt < size())
       str << ", ... ";
     str << " ]";
     return str.str();
   }
 
 protected:
-  std::list<DicePath> m_paths; // list of paths
+
+  static constexpr uint32_t NO_NODE = UINT32_MAX; // parent of the first die in a path
+
+  // Node in the prefix tree, i.e. a die and the node of its predecessor in the path
+  struct Node
+  {
+    int die_idx;
+    uint32_t parent;
+  };
+
+  // Returns true, if a cycle with the same canonical form has already been appended. Otherwise the hash of the canonical form is stored with the index
+  // of the path appended next. All paths with the same hash are materialized from the prefix tree and compared, i.e. a hash collision never drops a cycle.
+  bool is_duplicate_cycle(const DicePath& path)
+  {
+    bool mirror_equivalent = (m_deduplication == CANONICAL_ROTATION_AND_MIRROR);
+    DicePath canonical_path = path.canonical_cycle(mirror_equivalent);
+    uint64_t hash = canonical_path.hash();
+    auto hash_range = m_canonical_cycles.equal_range(hash);
+    for (auto hash_iter = hash_range.first; hash_iter != hash_range.second; hash_iter++)
+      if (at(hash_iter->second).canonical_cycle(mirror_equivalent) == canonical_path)
+        return true;
+    m_canonical_cycles.insert(std::make_pair(hash, (uint32_t)size()));
+    return false;
+  }
+
+  std::vector<Node> m_nodes; // prefix tree of all paths
+  std::vector<uint32_t> m_leaves; // last node of each path
+  std::vector<uint32_t> m_last_path_nodes; // nodes of the last appended path, shared with the next path
+  CycleDeduplication m_deduplication = NO_DEDUPLICATION; // removal of duplicated cycles on append
+  std::unordered_multimap<uint64_t, uint32_t> m_canonical_cycles; // hash of the canonical form of all appended cycles and their path index, if m_deduplication != NO_DEDUPLICATION
+};
+
+// Result of a search, which may stop before all paths have been found
+enum DiceSearchStatus
+{
+  SEARCH_COMPLETE,          // all paths have been found
+  SEARCH_MAX_OPEN_PATHS,    // the search has finished, but skipped paths exceeding max_open_paths
+  SEARCH_MAX_PATHS,         // stopped after max_final_paths or by the visitor callback
+  SEARCH_DEADLINE_EXCEEDED, // stopped at the deadline, the paths found before are returned
+  SEARCH_MEMORY_EXCEEDED    // stopped at the memory budget, the paths found before are returned
+};
+
+// Limits of a search for closed cycles, which are checked at each recursion point resp. every 1024 backtracking steps
+struct DiceSearchLimits
+{
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max(); // the search stops at this time
+  size_t max_memory_bytes = SIZE_MAX; // the search stops, if the open paths and the found paths exceed this number of bytes
+
+  // Returns limits with a deadline in a given number of seconds from now and an optional memory budget
+  static DiceSearchLimits timeout(double seconds, size_t max_memory_bytes = SIZE_MAX)
+  {
+    DiceSearchLimits limits;
+    limits.deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+    limits.max_memory_bytes = max_memory_bytes;
+    return limits;
+  }
+};
+
+// DicePathVisitor streams the closed cycles found by a search to a callback instead of collecting them in a DicePathList.
+// The search stops, if the callback returns false, if max_paths have been visited, or if the deadline or memory budget of the limits are exceeded.
+class DicePathVisitor
+{
+public:
+
+  // Initializing constructor given the callback, the max. number of paths to visit and the limits of the search.
+  // If result_memory_bytes is given, it returns the memory of the paths collected by the callback, which counts for the memory budget.
+  DicePathVisitor(const std::function<bool(const DicePath& path)>& callback, size_t max_paths = INT_MAX, const DiceSearchLimits& limits = DiceSearchLimits(),
+    const std::function<size_t(void)>& result_memory_bytes = nullptr) : m_callback(callback), m_max_paths(max_paths), m_limits(limits), m_result_memory_bytes(result_memory_bytes) {}
+
+  // Passes a path to the callback. Returns true, if the search should continue, or false otherwise.
+  bool visit(const DicePath& path)
+  {
+    if (done())
+      return false;
+    m_num_paths++;
+    if (!m_callback(path))
+      m_stopped = true;
+    if (m_observer)
+      m_observer(path);
+    return !done();
+  }
+
+  // Returns true, if the search should stop, i.e. the callback returned false, max_paths have been visited or a limit has been exceeded
+  bool done(void) const { return m_stopped || m_num_paths >= m_max_paths || m_limit_status != SEARCH_COMPLETE; }
+
+  // Checks the deadline and the memory budget given the bytes allocated by the search engine (e.g. for open paths).
+  // Returns true, if the search may continue, or false, if a limit has been exceeded.
+  bool within_limits(size_t engine_memory_bytes = 0)
+  {
+    if (m_limit_status == SEARCH_COMPLETE)
+    {
+      if (m_limits.deadline != std::chrono::steady_clock::time_point::max() && std::chrono::steady_clock::now() >= m_limits.deadline)
+        m_limit_status = SEARCH_DEADLINE_EXCEEDED;
+      else if (m_limits.max_memory_bytes != SIZE_MAX && engine_memory_bytes + (m_result_memory_bytes ? m_result_memory_bytes() : 0)
+        + (m_observer_memory_bytes ? m_observer_memory_bytes() : 0) > m_limits.max_memory_bytes)
+        m_limit_status = SEARCH_MEMORY_EXCEEDED;
+    }
+    return m_limit_status == SEARCH_COMPLETE;
+  }
+
+  // Sets an observer, which is called for each visited path after the callback, e.g. to collect the reversed beat cycles as lose cycles.
+  // If observer_memory_bytes is given, it returns the memory allocated by the observer, which counts for the memory budget.
+  void set_observer(const std::function<void(const DicePath& path)>& observer, const std::function<size_t(void)>& observer_memory_bytes = nullptr)
+  {
+    m_observer = observer;
+    m_observer_memory_bytes = observer_memory_bytes;
+  }
+
+  // Records that the search skipped paths exceeding max_open_paths (without stopping the search)
+  void skipped_open_paths(void) { m_skipped_open_paths = true; }
+
+  // Returns the status of the search
+  DiceSearchStatus status(void) const
+  {
+    if (m_limit_status != SEARCH_COMPLETE)
+      return m_limit_status;
+    if (m_stopped || m_num_paths >= m_max_paths)
+      return SEARCH_MAX_PATHS;
+    return m_skipped_open_paths ? SEARCH_MAX_OPEN_PATHS : SEARCH_COMPLETE;
+  }
+
+  // Returns true, if the callback requested to stop the search
+  bool stopped(void) const { return m_stopped; }
+
+  // Returns the number of visited paths
+  size_t num_paths(void) const { return m_num_paths; }
+
+  // Returns the max. number of paths to visit
+  size_t max_paths(void) const { return m_max_paths; }
+
+protected:
+
+  std::function<bool(const DicePath& path)> m_callback; // called for each path found
+  size_t m_max_paths = INT_MAX; // the search stops after max_paths
+  size_t m_num_paths = 0; // number of visited paths
+  bool m_stopped = false; // becomes true, if the callback returned false
+  DiceSearchLimits m_limits; // deadline and memory budget
+  std::function<size_t(void)> m_result_memory_bytes; // returns the memory of the paths collected by the callback
+  std::function<void(const DicePath& path)> m_observer; // optional, called for each visited path after the callback
+  std::function<size_t(void)> m_observer_memory_bytes; // returns the memory allocated by the observer
+  DiceSearchStatus m_limit_status = SEARCH_COMPLETE; // SEARCH_DEADLINE_EXCEEDED or SEARCH_MEMORY_EXCEEDED after a limit has been exceeded
+  bool m_skipped_open_paths = false; // becomes true, if paths exceeding max_open_paths have been skipped
 };
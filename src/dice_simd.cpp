@@ -0,0 +1,174 @@
+// Vectorized beat counting for dice with runtime CPU dispatch
+#include <algorithm>
+#include <assert.h>
+#include <bitset>
+#include "dice_simd.h"
+
+// AVX2 and AVX-512 kernels are compiled for x86-64 only. GCC and Clang compile them with function target attributes,
+// MSVC accepts the intrinsics without additional compiler options. Other platforms use the scalar kernel.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DICE_SIMD_X86 1
+#define DICE_SIMD_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define DICE_SIMD_X86 1
+#define DICE_SIMD_TARGET(isa)
+#include <immintrin.h>
+#include <intrin.h>
+#else
+#define DICE_SIMD_X86 0
+#endif
+
+namespace DiceSimd
+{
+#if DICE_SIMD_X86
+
+    // AVX2 kernel: advances the merge pointers into B by 4 values per packed compare.
+    // Since B is sorted, the compare mask of (A[i] > B[j..j+3]) is a run of ones followed by zeros, so its popcount is the pointer increment.
+    DICE_SIMD_TARGET("avx2") static std::array<size_t, 2> count_beats_avx2(const int64_t* A, size_t num_A, const int64_t* B, size_t num_B)
+    {
+        std::array<size_t, 2> beat_cnt = { 0, 0 };
+        size_t num_less = 0; // number of values in B with B[j] < A[i]
+        size_t num_less_equal = 0; // number of values in B with B[j] <= A[i]
+        for (size_t i = 0; i < num_A; i++)
+        {
+            const __m256i a_vec = _mm256_set1_epi64x(A[i]);
+            while (num_less + 4 <= num_B)
+            {
+                int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(a_vec, _mm256_loadu_si256((const __m256i*)(B + num_less))))); // A[i] > B[j]
+                num_less += std::bitset<4>(mask).count();
+                if (mask != 0xF)
+                    break;
+            }
+            while (num_less < num_B && B[num_less] < A[i])
+                num_less++;
+            num_less_equal = std::max(num_less_equal, num_less);
+            while (num_less_equal + 4 <= num_B)
+            {
+                int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_loadu_si256((const __m256i*)(B + num_less_equal)), a_vec))); // B[j] > A[i]
+                num_less_equal += 4 - std::bitset<4>(mask).count();
+                if (mask != 0)
+                    break;
+            }
+            while (num_less_equal < num_B && B[num_less_equal] <= A[i])
+                num_less_equal++;
+            beat_cnt[0] += num_less;
+            beat_cnt[1] += num_B - num_less_equal;
+        }
+        return beat_cnt;
+    }
+
+    // AVX-512 kernel: advances the merge pointers into B by 8 values per packed compare, see count_beats_avx2.
+    DICE_SIMD_TARGET("avx512f") static std::array<size_t, 2> count_beats_avx512(const int64_t* A, size_t num_A, const int64_t* B, size_t num_B)
+    {
+        std::array<size_t, 2> beat_cnt = { 0, 0 };
+        size_t num_less = 0; // number of values in B with B[j] < A[i]
+        size_t num_less_equal = 0; // number of values in B with B[j] <= A[i]
+        for (size_t i = 0; i < num_A; i++)
+        {
+            const __m512i a_vec = _mm512_set1_epi64(A[i]);
+            while (num_less + 8 <= num_B)
+            {
+                unsigned int mask = _mm512_cmpgt_epi64_mask(a_vec, _mm512_loadu_si512((const void*)(B + num_less))); // A[i] > B[j]
+                num_less += std::bitset<8>(mask).count();
+                if (mask != 0xFF)
+                    break;
+            }
+            while (num_less < num_B && B[num_less] < A[i])
+                num_less++;
+            num_less_equal = std::max(num_less_equal, num_less);
+            while (num_less_equal + 8 <= num_B)
+            {
+                unsigned int mask = _mm512_cmpgt_epi64_mask(_mm512_loadu_si512((const void*)(B + num_less_equal)), a_vec); // B[j] > A[i]
+                num_less_equal += 8 - std::bitset<8>(mask).count();
+                if (mask != 0)
+                    break;
+            }
+            while (num_less_equal < num_B && B[num_less_equal] <= A[i])
+                num_less_equal++;
+            beat_cnt[0] += num_less;
+            beat_cnt[1] += num_B - num_less_equal;
+        }
+        return beat_cnt;
+    }
+
+#endif // DICE_SIMD_X86
+
+    // Returns true, if the CPU supports a given instruction set
+    bool is_supported(SimdLevel level)
+    {
+        if (level == SimdLevel::SCALAR)
+            return true;
+#if DICE_SIMD_X86 && defined(_MSC_VER) && !defined(__clang__)
+        int cpu_info[4] = { 0, 0, 0, 0 };
+        __cpuid(cpu_info, 1);
+        bool os_saves_ymm = (cpu_info[2] & (1 << 27)) != 0 && (cpu_info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6; // OSXSAVE, AVX and OS support for ymm registers
+        if (!os_saves_ymm)
+            return false;
+        __cpuidex(cpu_info, 7, 0);
+        if (level == SimdLevel::AVX2)
+            return (cpu_info[1] & (1 << 5)) != 0;
+        if (level == SimdLevel::AVX512)
+            return (cpu_info[1] & (1 << 16)) != 0 && (_xgetbv(0) & 0xE6) == 0xE6; // AVX512F and OS support for zmm registers
+#elif DICE_SIMD_X86
+        __builtin_cpu_init();
+        if (level == SimdLevel::AVX2)
+            return __builtin_cpu_supports("avx2");
+        if (level == SimdLevel::AVX512)
+            return __builtin_cpu_supports("avx512f");
+#endif
+        return false;
+    }
+
+    // Returns the best instruction set supported by the CPU
+    SimdLevel detect_simd_level(void)
+    {
+        if (is_supported(SimdLevel::AVX512))
+            return SimdLevel::AVX512;
+        if (is_supported(SimdLevel::AVX2))
+            return SimdLevel::AVX2;
+        return SimdLevel::SCALAR;
+    }
+
+    // Returns the instruction set used by count_beats_sorted, i.e. the best supported instruction set detected at startup
+    SimdLevel active_simd_level(void)
+    {
+        static const SimdLevel s_active_level = detect_simd_level();
+        return s_active_level;
+    }
+
+    // Returns the name of an instruction set, e.g. "AVX2"
+    std::string name(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::AVX2:
+            return "AVX2";
+        case SimdLevel::AVX512:
+            return "AVX-512";
+        default:
+            return "scalar";
+        }
+    }
+
+    // Counts the number of pairs (a, b) with a > b and a < b for all a in A and b in B, i.e. returns the number of A-beats-B and B-beats-A outcomes.
+    // A and B must be sorted in ascending order. The merge pointers into B are advanced by packed compares of 4 (AVX2) or 8 (AVX-512) values.
+    std::array<size_t, 2> count_beats_sorted(const int64_t* A, size_t num_A, const int64_t* B, size_t num_B)
+    {
+        return count_beats_sorted(A, num_A, B, num_B, active_simd_level());
+    }
+
+    // Counts the number of pairs (a, b) with a > b and a < b using a given instruction set, which must be supported by the CPU (see is_supported).
+    std::array<size_t, 2> count_beats_sorted(const int64_t* A, size_t num_A, const int64_t* B, size_t num_B, SimdLevel level)
+    {
+        assert(std::is_sorted(A, A + num_A) && std::is_sorted(B, B + num_B));
+#if DICE_SIMD_X86
+        if (level == SimdLevel::AVX512)
+            return count_beats_avx512(A, num_A, B, num_B);
+        if (level == SimdLevel::AVX2)
+            return count_beats_avx2(A, num_A, B, num_B);
+#endif
+        return count_beats_scalar(A, num_A, B, num_B);
+    }
+
+} // namespace DiceSimd
@@ -0,0 +1,59 @@
+// Vectorized beat counting for dice with runtime CPU dispatch
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+
+// DiceSimd implements AVX2 and AVX-512 versions of the beat counting kernel with a scalar fallback.
+// The instruction set is detected once at startup from the CPU's reported features.
+namespace DiceSimd
+{
+    // Instruction sets for beat counting
+    enum SimdLevel
+    {
+        SCALAR, // portable scalar code, always supported
+        AVX2,   // compares 4 int64 values at once
+        AVX512  // compares 8 int64 values at once
+    };
+
+    // Returns true, if the CPU supports a given instruction set
+    bool is_supported(SimdLevel level);
+
+    // Returns the best instruction set supported by the CPU
+    SimdLevel detect_simd_level(void);
+
+    // Returns the instruction set used by count_beats_sorted, i.e. the best supported instruction set detected at startup
+    SimdLevel active_simd_level(void);
+
+    // Returns the name of an instruction set, e.g. "AVX2"
+    std::string name(SimdLevel level);
+
+    // Scalar kernel: counts the number of pairs (a, b) with a > b and a < b for all a in A and b in B, i.e. returns the number of A-beats-B and B-beats-A outcomes.
+    // A and B must be sorted in ascending order. Both arrays are merged once with two pointers in O(num_A + num_B), ties a == b are counted neither as win nor as loss.
+    template <typename A_type, typename B_type> std::array<size_t, 2> count_beats_scalar(const A_type* A, size_t num_A, const B_type* B, size_t num_B)
+    {
+        std::array<size_t, 2> beat_cnt = { 0, 0 };
+        size_t num_less = 0; // number of values in B with B[j] < A[i], i.e. A[i] beats B[0], ..., B[num_less-1]
+        size_t num_less_equal = 0; // number of values in B with B[j] <= A[i], i.e. A[i] loses against B[num_less_equal], ..., B[num_B-1]
+        for (size_t i = 0; i < num_A; i++)
+        {
+            while (num_less < num_B && B[num_less] < A[i])
+                num_less++;
+            num_less_equal = std::max(num_less_equal, num_less);
+            while (num_less_equal < num_B && B[num_less_equal] <= A[i])
+                num_less_equal++;
+            beat_cnt[0] += num_less;
+            beat_cnt[1] += num_B - num_less_equal;
+        }
+        return beat_cnt;
+    }
+
+    // Counts the number of pairs (a, b) with a > b and a < b for all a in A and b in B, i.e. returns the number of A-beats-B and B-beats-A outcomes.
+    // A and B must be sorted in ascending order. The merge pointers into B are advanced by packed compares of 4 (AVX2) or 8 (AVX-512) values.
+    std::array<size_t, 2> count_beats_sorted(const int64_t* A, size_t num_A, const int64_t* B, size_t num_B);
+
+    // Counts the number of pairs (a, b) with a > b and a < b using a given instruction set, which must be supported by the CPU (see is_supported).
+    std::array<size_t, 2> count_beats_sorted(const int64_t* A, size_t num_A, const int64_t* B, size_t num_B, SimdLevel level);
+
+} // namespace DiceSimd
@@ -0,0 +1,89 @@
+// Work-stealing thread pool for the parallel search of intransitive dice
+#pragma once
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// DiceThreadPool runs a list of independent tasks on multiple threads. Each worker has its own task deque: a worker takes its next task
+// from the front of its own deque, and steals a task from the back of another deque, if its own deque is empty. Tasks with small indices
+// are therefore processed first, while expensive tasks are balanced by stealing.
+class DiceThreadPool
+{
+public:
+
+  // Creates a pool with a given number of threads, or one thread per core if num_threads is 0
+  DiceThreadPool(size_t num_threads = 0) : m_num_threads(num_threads)
+  {
+    if (m_num_threads == 0)
+      m_num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+
+  // Returns the number of threads
+  size_t num_threads(void) const { return m_num_threads; }
+
+  // Runs task(task_idx, worker_idx) for all 0 <= task_idx < num_tasks and returns after all tasks are finished.
+  // worker_idx < num_threads() identifies the thread running a task, e.g. to collect results without locking.
+  void run(size_t num_tasks, const std::function<void(size_t task_idx, size_t worker_idx)>& task)
+  {
+    size_t num_workers = std::min(m_num_threads, num_tasks);
+    if (num_workers == 0)
+      return;
+    std::vector<WorkerQueue> queues(num_workers);
+    for (size_t task_idx = 0; task_idx < num_tasks; task_idx++) // round robin, such that all workers start with the smallest task indices
+      queues[task_idx % num_workers].tasks.push_back(task_idx);
+    auto worker = [&](size_t worker_idx)
+    {
+      size_t task_idx = 0;
+      while (pop_front(queues[worker_idx], task_idx) || steal(queues, worker_idx, task_idx))
+        task(task_idx, worker_idx);
+    };
+    std::vector<std::thread> threads;
+    for (size_t worker_idx = 1; worker_idx < num_workers; worker_idx++)
+      threads.push_back(std::thread(worker, worker_idx));
+    worker(0);
+    for (size_t n = 0; n < threads.size(); n++)
+      threads[n].join();
+  }
+
+protected:
+
+  // Task deque of a single worker
+  struct WorkerQueue
+  {
+    std::mutex mutex;
+    std::deque<size_t> tasks;
+  };
+
+  // Takes the next task from the front of the worker's own deque
+  static bool pop_front(WorkerQueue& queue, size_t& task_idx)
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+      return false;
+    task_idx = queue.tasks.front();
+    queue.tasks.pop_front();
+    return true;
+  }
+
+  // Steals a task from the back of another worker's deque
+  static bool steal(std::vector<WorkerQueue>& queues, size_t worker_idx, size_t& task_idx)
+  {
+    for (size_t n = 1; n < queues.size(); n++)
+    {
+      WorkerQueue& victim = queues[(worker_idx + n) % queues.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty())
+      {
+        task_idx = victim.tasks.back();
+        victim.tasks.pop_back();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  size_t m_num_threads = 1; // number of worker threads including the calling thread
+};
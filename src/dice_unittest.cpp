@@ -1,6 +1,12 @@
 // Unittests for dice generation
 #include <assert.h>
+#include <algorithm>
+#include <cfloat>
+#include <random>
+#include <set>
+#include <sstream>
 #include <dice_generator.h>
+#include "dice_simd.h"
 #include "dice_unittest.h"
 
 namespace DiceUnittest
@@ -41,10 +47,787 @@ namespace DiceUnittest
         return success;
     }
 
+    // Run a unit test for beat counting, i.e. check that all supported SIMD dispatch paths count identical wins and losses
+    bool count_beats_test(DiceLogger& logger, int num_tests)
+    {
+        std::mt19937 random_generator(0);
+        std::vector<DiceSimd::SimdLevel> simd_levels = { DiceSimd::SimdLevel::SCALAR, DiceSimd::SimdLevel::AVX2, DiceSimd::SimdLevel::AVX512 };
+        for (int test_cnt = 0; test_cnt < num_tests; test_cnt++)
+        {
+            // Random dice with 1 to 64 sides and a small value range, so that runs of equal values and ties occur frequently
+            std::uniform_int_distribution<int> num_sides_distribution(1, 64);
+            std::uniform_int_distribution<DieValueT> value_distribution(-8, 24);
+            std::vector<DieValueT> A(num_sides_distribution(random_generator)), B(num_sides_distribution(random_generator));
+            for (size_t n = 0; n < A.size(); n++)
+                A[n] = value_distribution(random_generator);
+            for (size_t n = 0; n < B.size(); n++)
+                B[n] = value_distribution(random_generator);
+            std::sort(A.begin(), A.end());
+            std::sort(B.begin(), B.end());
+            std::array<size_t, 2> expected_cnt = { 0, 0 };
+            for (size_t i = 0; i < A.size(); i++)
+            {
+                for (size_t j = 0; j < B.size(); j++)
+                {
+                    if (A[i] > B[j])
+                        expected_cnt[0]++;
+                    else if (B[j] > A[i])
+                        expected_cnt[1]++;
+                }
+            }
+            for (size_t level_idx = 0; level_idx < simd_levels.size(); level_idx++)
+            {
+                if (!DiceSimd::is_supported(simd_levels[level_idx]))
+                    continue;
+                std::array<size_t, 2> beat_cnt = DiceSimd::count_beats_sorted(A.data(), A.size(), B.data(), B.size(), simd_levels[level_idx]);
+                if (beat_cnt != expected_cnt)
+                {
+                    logger.cerr() << "## ERROR count_beats_test with A = (" << DiceUtil::print(A) << " ), B = (" << DiceUtil::print(B) << " ): " << DiceSimd::name(simd_levels[level_idx])
+                        << " counts " << beat_cnt[0] << ", " << beat_cnt[1] << ", expected " << expected_cnt[0] << ", " << expected_cnt[1] << std::endl << std::endl;
+                    return false;
+                }
+            }
+        }
+        logger.cout() << "Unittest passed: count_beats identical for all supported instruction sets (";
+        for (size_t level_idx = 0; level_idx < simd_levels.size(); level_idx++)
+            if (DiceSimd::is_supported(simd_levels[level_idx]))
+                logger.cout() << (level_idx > 0 ? ", " : "") << DiceSimd::name(simd_levels[level_idx]);
+        logger.cout() << "), active: " << DiceSimd::name(DiceSimd::active_simd_level()) << std::endl << std::endl;
+        return true;
+    }
+
+    // Run a unit test for multi dice, i.e. check that the histogram of dice sums counts identical wins and losses as all combinations of dice sums,
+    // which are generated from the values of the single dice independent of the histogram
+    bool multi_die_test(DiceLogger& logger)
+    {
+        MultiDiceSet multi_dice_set = DiceGenerator::create_multi_dice_set_munnoz_perera(18, 3);
+        for (size_t i = 0; i < multi_dice_set.size(); i++)
+        {
+            for (size_t j = 0; j < multi_dice_set.size(); j++)
+            {
+                const MultiDie& die_i = multi_dice_set.at(i);
+                const MultiDie& die_j = multi_dice_set.at(j);
+                std::vector<DieValueT> values_i, values_j; // all combinations of dice sums
+                DiceUtil::generate_sums_recursively(die_i.die_values(), 0, (DieValueT)0, values_i);
+                DiceUtil::generate_sums_recursively(die_j.die_values(), 0, (DieValueT)0, values_j);
+                Die sums_i(values_i), sums_j(values_j);
+                std::array<size_t, 2> beat_cnt = die_i.count_beats(die_j);
+                std::array<size_t, 2> expected_cnt = sums_i.count_beats(sums_j);
+                if (beat_cnt != expected_cnt || die_i.num_values() != sums_i.num_values())
+                {
+                    logger.cerr() << "## ERROR multi_die_test with D" << i << " = (" << die_i.print() << " ), D" << j << " = (" << die_j.print() << " ): histogram counts " << beat_cnt[0] << ", " << beat_cnt[1]
+                        << ", expected " << expected_cnt[0] << ", " << expected_cnt[1] << std::endl << std::endl;
+                    return false;
+                }
+            }
+        }
+        const MultiDie shared_die = multi_dice_set.at(0); // sums expanded on demand by concurrent threads
+        std::vector<std::vector<DieValueT>> concurrent_values(4);
+        std::vector<std::thread> threads;
+        for (size_t n = 0; n < concurrent_values.size(); n++)
+            threads.push_back(std::thread([&, n]() { concurrent_values[n] = shared_die.values(); }));
+        for (size_t n = 0; n < threads.size(); n++)
+            threads[n].join();
+        for (size_t n = 0; n < concurrent_values.size(); n++)
+        {
+            if (concurrent_values[n].size() != shared_die.num_values() || concurrent_values[n] != multi_dice_set.at(0).values())
+            {
+                logger.cerr() << "## ERROR multi_die_test: dice sums expanded concurrently differ for D0 = (" << shared_die.print() << " )" << std::endl << std::endl;
+                return false;
+            }
+        }
+        bool overflow_rejected = false; // 6^13 combinations of dice sums overflow the number of outcomes of two multi dice
+        try
+        {
+            MultiDie overflowing_die(std::vector<std::vector<DieValueT>>(13, { 1, 2, 3, 4, 5, 6 }));
+        }
+        catch (const std::overflow_error&)
+        {
+            overflow_rejected = true;
+        }
+        if (!overflow_rejected)
+        {
+            logger.cerr() << "## ERROR multi_die_test: 13 6-sided dice not rejected, 6^13 combinations of dice sums overflow" << std::endl << std::endl;
+            return false;
+        }
+        logger.cout() << "Unittest passed: histogram of dice sums identical to all combinations of dice sums for " << multi_dice_set.name() << std::endl << std::endl;
+        return true;
+    }
+
+    // Appends all simple cycles with at most max_length vertices, which start at path.front() and continue a given path with larger vertices (exhaustive search)
+    static void append_simple_cycles(const BitMatrix& graph, std::vector<int>& path, size_t max_length, std::vector<std::vector<int>>& cycles)
+    {
+        for (int w = 0; w < (int)graph.size(); w++)
+        {
+            if (!graph.at(path.back(), w))
+                continue;
+            if (w == path.front())
+            {
+                cycles.push_back(path);
+                cycles.back().push_back(w);
+            }
+            else if (w > path.front() && std::find(path.begin(), path.end(), w) == path.end() && path.size() < max_length)
+            {
+                path.push_back(w);
+                append_simple_cycles(graph, path, max_length, cycles);
+                path.pop_back();
+            }
+        }
+    }
+
+    // Run a unit test for the bit matrix and strongly connected components, i.e. check Tarjan's algorithm against the reachability of random graphs,
+    // check the simple cycles of small random graphs against an exhaustive search, and check the Hamiltonian cycles in random tournaments
+    bool graph_test(DiceLogger& logger, int num_tests)
+    {
+        std::mt19937 random_generator(4711);
+        for (int test_cnt = 0; test_cnt < num_tests; test_cnt++)
+        {
+            int N = 2 + (int)(random_generator() % 70); // up to 71 vertices, i.e. rows of more than one word
+            double edge_probability = 1.0 / (1 + random_generator() % N);
+            std::uniform_real_distribution<double> random_edge(0.0, 1.0);
+            BitMatrix graph(N);
+            std::vector<std::vector<bool>> reachable(N, std::vector<bool>(N, false));
+            for (int i = 0; i < N; i++)
+            {
+                reachable[i][i] = true;
+                for (int j = 0; j < N; j++)
+                    if (i != j && random_edge(random_generator) < edge_probability)
+                    {
+                        graph.set(i, j);
+                        reachable[i][j] = true;
+                    }
+            }
+            for (int k = 0; k < N; k++) // transitive closure by Floyd-Warshall
+                for (int i = 0; i < N; i++)
+                    if (reachable[i][k])
+                        for (int j = 0; j < N; j++)
+                            if (reachable[k][j])
+                                reachable[i][j] = true;
+            std::vector<int> component_of_vertex;
+            size_t num_components = DiceGraph::strongly_connected_components(graph, component_of_vertex);
+            DiceGraph::ReachabilityIndex reachability(graph);
+            bool success = (num_components == 1) == DiceGraph::is_strongly_connected(graph) && reachability.num_components() == num_components;
+            for (int i = 0; i < N && success; i++)
+            {
+                bool on_cycle = false;
+                for (int j = 0; j < N && success; j++)
+                {
+                    success = (component_of_vertex[i] == component_of_vertex[j]) == (reachable[i][j] && reachable[j][i])
+                        && reachability.same_component(i, j) == (component_of_vertex[i] == component_of_vertex[j]) && (i == j || reachability.can_reach(i, j) == reachable[i][j]);
+                    on_cycle = on_cycle || (i != j && reachable[i][j] && reachable[j][i]);
+                }
+                success = success && reachability.on_cycle(i) == on_cycle;
+            }
+            if (!success)
+            {
+                logger.cerr() << "## ERROR graph_test: strongly connected components (" << num_components << ") do not match the reachability of graph" << std::endl << graph.print() << std::endl;
+                return false;
+            }
+            // Simple cycles of small graphs: Johnson's algorithm with length bounds finds the same cycles as an exhaustive search
+            if (N <= 9)
+            {
+                size_t max_length = 2 + random_generator() % N;
+                std::vector<std::vector<int>> expected_cycles, cycles;
+                for (int v = 0; v < N; v++)
+                {
+                    std::vector<int> path(1, v);
+                    append_simple_cycles(graph, path, max_length, expected_cycles);
+                }
+                DiceGraph::enumerate_simple_cycles(graph, 2, max_length, [&](const std::vector<int>& cycle) { cycles.push_back(cycle); return true; }, 1 + test_cnt % 3);
+                std::sort(expected_cycles.begin(), expected_cycles.end());
+                std::sort(cycles.begin(), cycles.end());
+                std::vector<int> longest_cycle;
+                bool cycle_found = DiceGraph::find_longest_simple_cycle(graph, longest_cycle, 1 + test_cnt % 3);
+                if (cycles != expected_cycles || (max_length == (size_t)N && cycle_found != !cycles.empty())
+                    || (max_length == (size_t)N && cycle_found && longest_cycle.size() != std::max_element(cycles.begin(), cycles.end(), [](const std::vector<int>& a, const std::vector<int>& b) { return a.size() < b.size(); })->size()))
+                {
+                    logger.cerr() << "## ERROR graph_test: " << cycles.size() << " simple cycles found, expected " << expected_cycles.size() << " simple cycles of max. length " << max_length << " in graph" << std::endl << graph.print() << std::endl;
+                    return false;
+                }
+            }
+            // Random tournament: a Hamiltonian cycle exists, if and only if the tournament is strongly connected (Camion's theorem)
+            BitMatrix tournament(N);
+            for (int i = 0; i < N; i++)
+                for (int j = i + 1; j < N; j++)
+                    if (random_edge(random_generator) < 0.5 * edge_probability) // mostly transitive for small edge probabilities
+                        tournament.set(j, i);
+                    else
+                        tournament.set(i, j);
+            std::vector<int> cycle;
+            bool cycle_found = DiceGraph::find_hamiltonian_cycle_in_tournament(tournament, cycle);
+            success = DiceGraph::is_tournament(tournament) && cycle_found == (N >= 3 && DiceGraph::is_strongly_connected(tournament));
+            if (cycle_found)
+            {
+                std::vector<int> sorted_cycle(cycle.begin(), cycle.end() - 1);
+                std::sort(sorted_cycle.begin(), sorted_cycle.end());
+                success = success && cycle.size() == (size_t)N + 1 && cycle.front() == 0 && cycle.back() == 0 && std::adjacent_find(sorted_cycle.begin(), sorted_cycle.end()) == sorted_cycle.end();
+                for (size_t n = 1; n < cycle.size() && success; n++)
+                    success = tournament.at(cycle[n - 1], cycle[n]);
+            }
+            if (!success)
+            {
+                logger.cerr() << "## ERROR graph_test: invalid Hamiltonian cycle in tournament" << std::endl << tournament.print() << std::endl;
+                return false;
+            }
+            // Rotation-extension heuristic: a valid Hamiltonian cycle, independent of the number of threads
+            std::vector<int> heuristic_cycle, heuristic_cycle_parallel;
+            bool heuristic_cycle_found = DiceGraph::find_hamiltonian_cycle_by_rotation_extension(graph, heuristic_cycle, 8, 1);
+            DiceGraph::find_hamiltonian_cycle_by_rotation_extension(graph, heuristic_cycle_parallel, 8, 3);
+            if ((heuristic_cycle_found && !DiceGraph::is_hamiltonian_cycle(graph, heuristic_cycle)) || heuristic_cycle_parallel != heuristic_cycle
+                || (heuristic_cycle_found && (num_components != 1 || N < 3)))
+            {
+                logger.cerr() << "## ERROR graph_test: invalid Hamiltonian cycle (" << DiceUtil::print(heuristic_cycle) << ") found by rotation-extension in graph" << std::endl << graph.print() << std::endl;
+                return false;
+            }
+        }
+        logger.cout() << "Unittest passed: strongly connected components and transitive closure identical to reachability, simple cycles and Hamiltonian cycles found in " << num_tests << " random graphs and tournaments" << std::endl << std::endl;
+        return true;
+    }
+
+    // Returns the intransitive paths of a dice set found by a given cycle search engine, optionally sorted for comparison
+    static std::vector<std::string> search_paths(DiceSet& dice_set, CycleSearchStrategy strategy, size_t max_final_paths = INT_MAX, bool sort_paths = true)
+    {
+        dice_set.set_cycle_search_strategy(strategy);
+        const DicePathList& paths = dice_set.search_intransitive_paths(max_final_paths);
+        std::vector<std::string> printed_paths;
+        for (DicePathList::const_iterator path_iter = paths.cbegin(); path_iter != paths.cend(); path_iter++)
+            printed_paths.push_back(path_iter->print());
+        if (sort_paths)
+            std::sort(printed_paths.begin(), printed_paths.end());
+        return printed_paths;
+    }
+
+    // Returns num_tests random subsets of 3 to 9 Munnoz-Perera dice in random order, where every second subset has ties (coarsened values)
+    static std::vector<DiceSet> cycle_search_dice_sets(int num_tests)
+    {
+        std::mt19937 random_generator(4711);
+        const std::vector<Die> munnoz_perera_dice = DiceGenerator::munnoz_perera(12).dice();
+        std::vector<DiceSet> dice_sets;
+        for (int test_cnt = 0; test_cnt < num_tests; test_cnt++)
+        {
+            std::vector<Die> dice = munnoz_perera_dice;
+            std::shuffle(dice.begin(), dice.end(), random_generator);
+            dice.resize(3 + random_generator() % 7);
+            if (test_cnt % 2 != 0) // values v / q with q = 8 to 24 cause ties P(D_i>D_j) = P(D_j>D_i), i.e. the lose matrix is not the transposed beat matrix
+            {
+                dice.resize(std::min<size_t>(dice.size(), 7)); // ties add many cycles
+                DieValueT q = 8 + random_generator() % 17;
+                for (size_t n = 0; n < dice.size(); n++)
+                {
+                    std::vector<DieValueT> values = dice[n].values();
+                    for (size_t m = 0; m < values.size(); m++)
+                        values[m] /= q;
+                    dice[n] = Die(values);
+                }
+            }
+            dice_sets.push_back(DiceSet((test_cnt % 2 == 0) ? "random subset of munnoz_perera(12)" : "random subset of munnoz_perera(12) with ties", dice));
+        }
+        return dice_sets;
+    }
+
+    // Run a unit test for the closed cycle search engines, i.e. check that all cycle search engines find identical intransitive paths in random subsets of
+    // Munnoz-Perera dice without and with ties, and that find_intransitive_path returns one of these paths
+    bool cycle_search_engine_test(DiceLogger& logger, int num_tests)
+    {
+        std::vector<DiceSet> dice_sets = cycle_search_dice_sets(num_tests);
+        for (int test_cnt = 0; test_cnt < num_tests; test_cnt++)
+        {
+            DiceSet& dice_set = dice_sets[test_cnt];
+            std::vector<std::string> open_path_list_paths = search_paths(dice_set, CycleSearchStrategy::OPEN_PATH_LIST);
+            std::vector<std::string> backtracking_paths = search_paths(dice_set, CycleSearchStrategy::BACKTRACKING);
+            dice_set.set_parallel_cycle_search(4, false);
+            std::vector<std::string> parallel_paths = search_paths(dice_set, CycleSearchStrategy::PARALLEL_BACKTRACKING);
+            if (open_path_list_paths != backtracking_paths || open_path_list_paths != parallel_paths)
+            {
+                logger.cerr() << "## ERROR cycle_search_engine_test: backtracking found " << backtracking_paths.size() << " paths, parallel backtracking found " << parallel_paths.size() << " paths, expected " << open_path_list_paths.size() << " paths in " << dice_set.name() << ":" << std::endl << dice_set.print_dice() << std::endl;
+                return false;
+            }
+            size_t max_final_paths = 1 + test_cnt % 8; // the stable parallel search must return the first paths of the sequential search in identical order
+            dice_set.set_parallel_cycle_search(4, true);
+            if (search_paths(dice_set, CycleSearchStrategy::PARALLEL_BACKTRACKING, max_final_paths, false) != search_paths(dice_set, CycleSearchStrategy::BACKTRACKING, max_final_paths, false))
+            {
+                logger.cerr() << "## ERROR cycle_search_engine_test: stable parallel backtracking paths differ from backtracking paths in " << dice_set.name() << ":" << std::endl << dice_set.print_dice() << std::endl;
+                return false;
+            }
+            DiceSet dice_set_copy("copy of " + dice_set.name(), dice_set.dice()); // without cached paths
+            if (test_cnt % 2 != 0)
+                dice_set_copy.set_first_path_strategy(FirstPathStrategy::ROTATION_EXTENSION, 8, 1, 0);
+            DicePath first_path;
+            if (dice_set_copy.find_intransitive_path(first_path) != (open_path_list_paths.size() > 0)
+                || (open_path_list_paths.size() > 0 && !std::binary_search(open_path_list_paths.begin(), open_path_list_paths.end(), first_path.print())))
+            {
+                logger.cerr() << "## ERROR cycle_search_engine_test: find_intransitive_path returned (" << first_path.print() << "), expected one of " << open_path_list_paths.size() << " paths in " << dice_set.name() << ":" << std::endl << dice_set.print_dice() << std::endl;
+                return false;
+            }
+        }
+        logger.cout() << "Unittest passed: identical intransitive paths found by all cycle search engines in " << num_tests << " random subsets of munnoz_perera(12) with and without ties" << std::endl << std::endl;
+        return true;
+    }
+
+    // Run a unit test for the streaming path search, i.e. check that visit_intransitive_paths streams the paths of search_intransitive_paths,
+    // stops when the visitor returns false, and streams all paths with a small buffer of reversed beat cycles
+    bool cycle_search_visitor_test(DiceLogger& logger, int num_tests)
+    {
+        std::vector<DiceSet> dice_sets = cycle_search_dice_sets(num_tests);
+        for (int test_cnt = 0; test_cnt < num_tests; test_cnt++)
+        {
+            DiceSet& dice_set = dice_sets[test_cnt];
+            std::vector<std::string> open_path_list_paths = search_paths(dice_set, CycleSearchStrategy::OPEN_PATH_LIST);
+            size_t max_final_paths = 1 + test_cnt % 8;
+            std::vector<std::string> visited_paths; // paths streamed by the stable parallel search, stopped by the callback after max_final_paths
+            dice_set.set_parallel_cycle_search(4, true);
+            dice_set.set_cycle_search_strategy(CycleSearchStrategy::PARALLEL_BACKTRACKING);
+            size_t num_visited_paths = dice_set.visit_intransitive_paths([&](const DicePath& path) { visited_paths.push_back(path.print()); return visited_paths.size() < max_final_paths; });
+            if (num_visited_paths != visited_paths.size() || visited_paths != search_paths(dice_set, CycleSearchStrategy::BACKTRACKING, max_final_paths, false))
+            {
+                logger.cerr() << "## ERROR cycle_search_visitor_test: visit_intransitive_paths streamed " << visited_paths.size() << " paths different from the first " << max_final_paths << " paths in " << dice_set.name() << ":" << std::endl << dice_set.print_dice() << std::endl;
+                return false;
+            }
+            visited_paths.clear(); // all paths streamed with a small buffer of reversed beat cycles, i.e. the lose matrix is searched after the buffer is exceeded
+            dice_set.set_cycle_search_strategy(CycleSearchStrategy::OPEN_PATH_LIST);
+            dice_set.set_max_streamed_reversed_paths(test_cnt % 4);
+            dice_set.visit_intransitive_paths([&](const DicePath& path) { visited_paths.push_back(path.print()); return true; });
+            dice_set.set_max_streamed_reversed_paths(4096);
+            std::sort(visited_paths.begin(), visited_paths.end());
+            if (visited_paths != open_path_list_paths)
+            {
+                logger.cerr() << "## ERROR cycle_search_visitor_test: visit_intransitive_paths streamed " << visited_paths.size() << " paths with a buffer of " << (test_cnt % 4) << " reversed beat paths, expected " << open_path_list_paths.size() << " paths in " << dice_set.name() << ":" << std::endl << dice_set.print_dice() << std::endl;
+                return false;
+            }
+        }
+        logger.cout() << "Unittest passed: intransitive paths streamed by visit_intransitive_paths in " << num_tests << " random subsets of munnoz_perera(12) with and without ties" << std::endl << std::endl;
+        return true;
+    }
+
+    // Run a unit test for the deduplicating path list, i.e. check that rotated copies of all paths are dropped as duplicates,
+    // and that a path and its reverse are dropped as mirror images
+    bool cycle_dedup_test(DiceLogger& logger, int num_tests)
+    {
+        std::mt19937 random_generator(4712); // random rotations
+        std::vector<DiceSet> dice_sets = cycle_search_dice_sets(num_tests);
+        for (int test_cnt = 0; test_cnt < num_tests; test_cnt++)
+        {
+            DiceSet& dice_set = dice_sets[test_cnt];
+            std::vector<std::string> open_path_list_paths = search_paths(dice_set, CycleSearchStrategy::OPEN_PATH_LIST);
+            DicePathList rotation_paths(CycleDeduplication::CANONICAL_ROTATION), mirror_paths(CycleDeduplication::CANONICAL_ROTATION_AND_MIRROR);
+            std::set<std::string> expected_mirror_paths;
+            for (size_t path_idx = 0; path_idx < open_path_list_paths.size(); path_idx++)
+            {
+                std::vector<int> dice_indices;
+                std::stringstream printed_path(open_path_list_paths[path_idx]);
+                for (int die_idx = 0; printed_path >> die_idx; )
+                    dice_indices.push_back(die_idx);
+                std::vector<int> reversed_dice_indices(dice_indices.rbegin(), dice_indices.rend());
+                rotation_paths.append(DicePath(dice_indices));
+                mirror_paths.append(DicePath(dice_indices));
+                expected_mirror_paths.insert(std::min(DicePath(dice_indices).print(), DicePath(reversed_dice_indices).print()));
+                std::rotate(dice_indices.begin(), dice_indices.begin() + 1 + random_generator() % (dice_indices.size() - 1), dice_indices.end() - 1);
+                dice_indices.back() = dice_indices.front();
+                rotation_paths.append(DicePath(dice_indices));
+                mirror_paths.append(DicePath(std::vector<int>(dice_indices.rbegin(), dice_indices.rend())));
+            }
+            if (rotation_paths.size() != open_path_list_paths.size() || mirror_paths.size() != expected_mirror_paths.size())
+            {
+                logger.cerr() << "## ERROR cycle_dedup_test: " << rotation_paths.size() << " paths after canonical rotation and " << mirror_paths.size() << " paths after canonical mirror, expected " << open_path_list_paths.size() << " and " << expected_mirror_paths.size() << " paths in " << dice_set.name() << ":" << std::endl << dice_set.print_dice() << std::endl;
+                return false;
+            }
+        }
+        logger.cout() << "Unittest passed: rotated and mirrored intransitive paths deduplicated in " << num_tests << " random subsets of munnoz_perera(12) with and without ties" << std::endl << std::endl;
+        return true;
+    }
+
+    // Run a unit test for counting intransitive paths, i.e. check that the number of paths and a sampled witness path match the path search
+    bool cycle_count_test(DiceLogger& logger, int num_tests)
+    {
+        std::vector<DiceSet> dice_sets = cycle_search_dice_sets(num_tests);
+        for (int test_cnt = 0; test_cnt < num_tests; test_cnt++)
+        {
+            DiceSet& dice_set = dice_sets[test_cnt];
+            std::vector<std::string> open_path_list_paths = search_paths(dice_set, CycleSearchStrategy::OPEN_PATH_LIST);
+            uint64_t num_paths = 0;
+            DicePath witness;
+            if (!dice_set.count_intransitive_paths(num_paths, &witness) || num_paths != open_path_list_paths.size()
+                || (num_paths > 0) != std::binary_search(open_path_list_paths.begin(), open_path_list_paths.end(), witness.print()))
+            {
+                logger.cerr() << "## ERROR cycle_count_test: counted " << num_paths << " paths with witness (" << witness.print() << "), expected " << open_path_list_paths.size() << " paths in " << dice_set.name() << ":" << std::endl << dice_set.print_dice() << std::endl;
+                return false;
+            }
+        }
+        logger.cout() << "Unittest passed: intransitive paths counted in " << num_tests << " random subsets of munnoz_perera(12) with and without ties" << std::endl << std::endl;
+        return true;
+    }
+
+    // Run a unit test for the most robust intransitive path, i.e. check that its bottleneck probability is the largest bottleneck of all paths
+    bool robust_path_test(DiceLogger& logger, int num_tests)
+    {
+        std::vector<DiceSet> dice_sets = cycle_search_dice_sets(num_tests);
+        for (int test_cnt = 0; test_cnt < num_tests; test_cnt++)
+        {
+            DiceSet& dice_set = dice_sets[test_cnt];
+            std::vector<std::string> open_path_list_paths = search_paths(dice_set, CycleSearchStrategy::OPEN_PATH_LIST);
+            double expected_bottleneck = 0.0, bottleneck = 0.0; // largest bottleneck probability of all paths
+            dice_set.set_cycle_search_strategy(CycleSearchStrategy::BACKTRACKING); // search all paths again
+            for (DicePathList::const_iterator path_iter = dice_set.search_intransitive_paths().cbegin(); path_iter != dice_set.search_intransitive_paths().cend(); path_iter++)
+            {
+                double path_bottleneck = 1.0;
+                bool beat_path = dice_set.probability_to_beat(path_iter->at(0), path_iter->at(1)) > 0.5;
+                for (size_t n = 1; n < path_iter->size(); n++)
+                {
+                    double probability_to_beat = dice_set.probability_to_beat(path_iter->at(n - 1), path_iter->at(n));
+                    path_bottleneck = std::min(path_bottleneck, beat_path ? probability_to_beat : (1.0 - probability_to_beat));
+                }
+                expected_bottleneck = std::max(expected_bottleneck, path_bottleneck);
+            }
+            DicePath robust_path;
+            if (dice_set.find_most_robust_intransitive_path(robust_path, bottleneck) != (open_path_list_paths.size() > 0) || std::abs(bottleneck - expected_bottleneck) > 1.0e-9
+                || (open_path_list_paths.size() > 0 && !std::binary_search(open_path_list_paths.begin(), open_path_list_paths.end(), robust_path.print())))
+            {
+                logger.cerr() << "## ERROR robust_path_test: most robust path (" << robust_path.print() << ") with bottleneck " << bottleneck << ", expected bottleneck " << expected_bottleneck << " in " << dice_set.name() << ":" << std::endl << dice_set.print_dice() << std::endl;
+                return false;
+            }
+        }
+        logger.cout() << "Unittest passed: most robust intransitive path found in " << num_tests << " random subsets of munnoz_perera(12) with and without ties" << std::endl << std::endl;
+        return true;
+    }
+
+    // Run a unit test for the simple cycle enumeration, i.e. check that the beat and lose cycles through all dice are the intransitive paths.
+    // The cycles are enumerated independently of the path search, which derives the lose cycles from reversed beat cycles without ties.
+    bool simple_cycle_test(DiceLogger& logger, int num_tests)
+    {
+        std::vector<DiceSet> dice_sets = cycle_search_dice_sets(num_tests);
+        for (int test_cnt = 0; test_cnt < num_tests; test_cnt++)
+        {
+            DiceSet& dice_set = dice_sets[test_cnt];
+            std::vector<std::string> open_path_list_paths = search_paths(dice_set, CycleSearchStrategy::OPEN_PATH_LIST);
+            std::vector<std::string> hamiltonian_cycles;
+            size_t num_hamiltonian_cycles = dice_set.visit_simple_intransitive_cycles([&](const DicePath& path) { hamiltonian_cycles.push_back(path.print()); return true; }, dice_set.size(), dice_set.size());
+            std::sort(hamiltonian_cycles.begin(), hamiltonian_cycles.end());
+            if (num_hamiltonian_cycles != open_path_list_paths.size() || hamiltonian_cycles != open_path_list_paths)
+            {
+                logger.cerr() << "## ERROR simple_cycle_test: " << num_hamiltonian_cycles << " simple cycles through all dice, expected " << open_path_list_paths.size() << " paths in " << dice_set.name() << ":" << std::endl << dice_set.print_dice() << std::endl;
+                return false;
+            }
+        }
+        logger.cout() << "Unittest passed: simple cycles through all dice identical to intransitive paths in " << num_tests << " random subsets of munnoz_perera(12) with and without ties" << std::endl << std::endl;
+        return true;
+    }
+
+    // Run a unit test for the limits of the path search, i.e. check that a search stops at the deadline resp. the memory budget,
+    // and that an incomplete result is not cached
+    bool search_limits_test(DiceLogger& logger)
+    {
+        DiceSet dice_set = DiceGenerator::munnoz_perera(11);
+        DiceSearchStatus deadline_status = SEARCH_COMPLETE, memory_status = SEARCH_COMPLETE, open_paths_status = SEARCH_COMPLETE, status = SEARCH_COMPLETE;
+        size_t num_deadline_paths = dice_set.search_intransitive_paths(DiceSearchLimits::timeout(0.0), deadline_status).size();
+        dice_set.set_cycle_search_strategy(CycleSearchStrategy::BACKTRACKING);
+        size_t memory_bytes = dice_set.search_intransitive_paths(DiceSearchLimits::timeout(60.0, 4096), memory_status).memory_bytes();
+        dice_set.set_cycle_search_strategy(CycleSearchStrategy::OPEN_PATH_LIST);
+        dice_set.search_intransitive_paths(DiceSearchLimits(), open_paths_status, INT_MAX, 10);
+        dice_set.set_cycle_search_strategy(CycleSearchStrategy::BACKTRACKING);
+        size_t num_paths = dice_set.search_intransitive_paths(DiceSearchLimits(), status).size();
+        uint64_t expected_num_paths = 0;
+        if (deadline_status != SEARCH_DEADLINE_EXCEEDED || num_deadline_paths != 0 || memory_status != SEARCH_MEMORY_EXCEEDED || memory_bytes > 2 * 4096
+            || open_paths_status != SEARCH_MAX_OPEN_PATHS || status != SEARCH_COMPLETE || !dice_set.count_intransitive_paths(expected_num_paths) || num_paths != expected_num_paths)
+        {
+            logger.cerr() << "## ERROR search_limits_test: status " << deadline_status << " with " << num_deadline_paths << " paths after deadline, status " << memory_status << " with " << memory_bytes << " bytes after memory budget, status "
+                << open_paths_status << " after max_open_paths, status " << status << " with " << num_paths << " paths without limits, expected " << expected_num_paths << " paths in " << dice_set.name() << std::endl;
+            return false;
+        }
+        logger.cout() << "Unittest passed: path search stopped at deadline and memory budget in " << dice_set.name() << std::endl << std::endl;
+        return true;
+    }
+
+    // Test of the symmetry-aware search: SYMMETRIC_BACKTRACKING finds the same paths as BACKTRACKING, and the expanded orbits
+    // of visit_intransitive_path_orbits are the paths of the Munnoz-Perera dice (circulant beat matrix)
+    bool symmetric_search_test(DiceLogger& logger)
+    {
+        for (int num_dice = 3; num_dice <= 10; num_dice++)
+        {
+            DiceSet dice_set = DiceGenerator::munnoz_perera(num_dice);
+            std::multiset<std::string> paths, symmetric_paths, orbit_paths;
+            dice_set.set_cycle_search_strategy(CycleSearchStrategy::BACKTRACKING);
+            dice_set.visit_intransitive_paths([&](const DicePath& path) { paths.insert(path.print()); return true; });
+            dice_set.set_cycle_search_strategy(CycleSearchStrategy::SYMMETRIC_BACKTRACKING);
+            dice_set.visit_intransitive_paths([&](const DicePath& path) { symmetric_paths.insert(path.print()); return true; });
+            size_t num_orbit_paths = 0;
+            size_t num_orbits = dice_set.visit_intransitive_path_orbits([&](const DicePath& path, size_t orbit_size)
+                {
+                    num_orbit_paths += orbit_size;
+                    std::vector<DicePath> orbit = dice_set.expand_path_orbit(path);
+                    for (size_t n = 0; n < orbit.size(); n++)
+                        orbit_paths.insert(orbit[n].print());
+                    return true;
+                });
+            if (paths.empty() || symmetric_paths != paths || orbit_paths != paths || num_orbit_paths != paths.size() || (num_orbits >= paths.size() && num_dice >= 7))
+            {
+                logger.cerr() << "## ERROR symmetric_search_test: " << symmetric_paths.size() << " symmetric paths, " << num_orbits << " orbits with " << num_orbit_paths << " paths ("
+                    << orbit_paths.size() << " expanded), expected " << paths.size() << " paths in " << dice_set.name() << std::endl;
+                return false;
+            }
+        }
+        logger.cout() << "Unittest passed: symmetric path search" << std::endl << std::endl;
+        return true;
+    }
+
+    // Test of the incremental beat matrix: the win counts after inserting, appending and removing dice and after an increasing affine map
+    // of all values are identical to the win counts computed from scratch
+    bool incremental_beat_matrix_test(DiceLogger& logger)
+    {
+        DiceSet dice_set = DiceGenerator::munnoz_perera(9), other_dice_set = DiceGenerator::munnoz_perera(9);
+        other_dice_set.mul_add_values(3, -40); // other dice with ties and new comparisons
+        dice_set.beat_matrix();
+        dice_set.remove(3);
+        dice_set.append(other_dice_set.dice()[4]);
+        dice_set.insert(2, other_dice_set.dice()[7]);
+        dice_set.insert(0, other_dice_set.dice()[1]);
+        dice_set.insert({ { 0, other_dice_set.dice()[0] }, { 4, other_dice_set.dice()[2] }, { 4, other_dice_set.dice()[3] }, { dice_set.size(), other_dice_set.dice()[5] } });
+        dice_set.remove(dice_set.size() - 2);
+        dice_set.mul_add_values(2, 1);
+        DiceSet expected_dice_set("expected " + dice_set.name(), dice_set.dice());
+        const BeatMatrix& counts = dice_set.beat_matrix();
+        const BeatMatrix& expected_counts = expected_dice_set.beat_matrix();
+        bool success = counts.size() == expected_counts.size() && counts.lose_is_transposed_beat() == expected_counts.lose_is_transposed_beat();
+        for (int i = 0; i < (int)counts.size() && success; i++)
+            for (int j = 0; j < (int)counts.size() && success; j++)
+                success = counts.wins(i, j) == expected_counts.wins(i, j) && counts.num_outcomes(i, j) == expected_counts.num_outcomes(i, j);
+        if (!success)
+        {
+            logger.cerr() << "## ERROR incremental_beat_matrix_test: incremental beat matrix differs from the beat matrix of " << dice_set.name() << ":" << std::endl << dice_set.print_dice() << std::endl;
+            return false;
+        }
+        logger.cout() << "Unittest passed: incremental beat matrix identical to recomputed beat matrix" << std::endl << std::endl;
+        return true;
+    }
+
+    // Run a unit test for the growable dice cycle, i.e. check that dice inserted in place into small chunks give the same intransitive cycle
+    // as dice inserted into a single chunk
+    bool dice_cycle_test(DiceLogger& logger)
+    {
+        DiceSet dice_set = DiceGenerator::munnoz_perera(6);
+        DicePath dice_path = DiceGenerator::munnoz_perera_path(6);
+        dice_set.mul_add_values(4, 0); // enlarge the values, so that new dice can be inserted between all dice
+        DiceCycle chunked_cycle(dice_set, dice_path, 4), single_chunk_cycle(dice_set, dice_path, 1000);
+        bool success = true;
+        while (success && chunked_cycle.size() < 100)
+        {
+            std::vector<size_t> inserted_dice_idx;
+            success = DiceGenerator::extend_cycle_by_intransitive_dice_insertion_once(chunked_cycle, 100, DiceGenerator::FindDieStrategy::THREE_LEVEL_INSERTION, 2, &inserted_dice_idx)
+                && DiceGenerator::extend_cycle_by_intransitive_dice_insertion_once(single_chunk_cycle, 100, DiceGenerator::FindDieStrategy::THREE_LEVEL_INSERTION, 1)
+                && !inserted_dice_idx.empty() && inserted_dice_idx.back() < chunked_cycle.size();
+        }
+        DiceSet extended_dice_set("Extended " + dice_set.name(), chunked_cycle.dice());
+        DicePath extended_dice_path = chunked_cycle.path();
+        success = success && chunked_cycle.size() == single_chunk_cycle.size() && extended_dice_path.size() == chunked_cycle.size() + 1;
+        for (size_t n = 0; success && n < chunked_cycle.size(); n++)
+            success = chunked_cycle.at(n).values() == single_chunk_cycle.at(n).values()
+                && extended_dice_set.probability_to_beat(extended_dice_path.at(n), extended_dice_path.at(n + 1)) > 0.5;
+        if (!success)
+        {
+            logger.cerr() << "## ERROR dice_cycle_test: dice inserted into a chunked cycle differ or are not intransitive" << std::endl;
+            return false;
+        }
+        logger.cout() << "Unittest passed: chunked dice cycle extended to " << chunked_cycle.size() << " intransitive dice" << std::endl << std::endl;
+        return true;
+    }
+
+    // Run a unit test for the failure-aware extension, i.e. check that opening gaps between the values of failed edges keeps all win counts,
+    // and that the failed edges of Munnoz-Perera dice can be extended after opening the gaps
+    bool value_gaps_test(DiceLogger& logger)
+    {
+        DiceSet dice_set = DiceGenerator::munnoz_perera(6);
+        DiceCycle dice_cycle(dice_set, DiceGenerator::munnoz_perera_path(6));
+        std::vector<size_t> failed_edges;
+        bool success = !DiceGenerator::extend_cycle_by_intransitive_dice_insertion_once(dice_cycle, 100, DiceGenerator::FindDieStrategy::THREE_LEVEL_INSERTION, 1, 0, 0, &failed_edges)
+            && failed_edges.size() == dice_cycle.num_edges(); // values 1, 2, ..., 36 without gaps: no die can be inserted
+        DiceSet cycle_dice_set("cycle " + dice_set.name(), dice_cycle.dice());
+        DiceGenerator::open_value_gaps(dice_cycle, failed_edges, 2);
+        DiceSet gap_dice_set("gaps " + dice_set.name(), dice_cycle.dice());
+        const BeatMatrix& counts = cycle_dice_set.beat_matrix();
+        const BeatMatrix& gap_counts = gap_dice_set.beat_matrix();
+        for (int i = 0; i < (int)counts.size() && success; i++)
+            for (int j = 0; j < (int)counts.size() && success; j++)
+                success = counts.wins(i, j) == gap_counts.wins(i, j);
+        std::vector<size_t> retry_edges = failed_edges;
+        success = success && DiceGenerator::extend_cycle_by_intransitive_dice_insertion_once(dice_cycle, 100, DiceGenerator::FindDieStrategy::THREE_LEVEL_INSERTION, 1, 0, &retry_edges, &failed_edges)
+            && dice_cycle.size() + failed_edges.size() == 2 * cycle_dice_set.size();
+        if (!success)
+        {
+            logger.cerr() << "## ERROR value_gaps_test: opening gaps changed the win counts or failed edges could not be extended:" << std::endl << gap_dice_set.print_dice() << std::endl;
+            return false;
+        }
+        logger.cout() << "Unittest passed: opened gaps keep all win counts, " << (cycle_dice_set.size() - failed_edges.size()) << " of " << cycle_dice_set.size() << " failed edges extended" << std::endl << std::endl;
+        return true;
+    }
+
+    // Reference implementation of the 3-level insertion, which builds each candidate die with values L, T, H and compares it to die_i and die_k
+    static Die find_die_between_two_others_by_candidate_dice(Die& die_i, Die& die_k)
+    {
+        die_i.sort_values();
+        die_k.sort_values();
+        size_t M = die_i.num_values();
+        const std::vector<DieValueT>& A = die_i.values();
+        const std::vector<DieValueT>& B = die_k.values();
+        if (die_i.probability_to_beat(die_k) <= 0.5)
+            return Die();
+        std::vector<DieValueT> dice_values(A);
+        dice_values.insert(dice_values.end(), B.begin(), B.end());
+        std::sort(dice_values.begin(), dice_values.end());
+        std::vector<double> candidates; // candidates for threshold t: mean of two different dice values
+        for (size_t n = 1; n < dice_values.size(); n++)
+            if (dice_values[n - 1] != dice_values[n])
+                candidates.push_back(0.5 * (dice_values[n - 1] + dice_values[n]));
+        for (size_t candidate_idx = 0; candidate_idx < candidates.size(); candidate_idx++)
+        {
+            double t = candidates[candidate_idx];
+            double FAt = DiceUtil::cdf(A, t), FBt = DiceUtil::cdf(B, t);
+            if (FAt >= FBt)
+                continue;
+            for (size_t mM = 1; mM < M; mM++)
+            {
+                size_t Lmin = (size_t)(0.5 * M - mM * (1.0 - FAt)) + 1;
+                size_t Lmax = std::min<size_t>(M - mM, (size_t)(0.5 * M + mM * (1 - FBt)));
+                if (Lmin > Lmax)
+                    continue;
+                size_t mL = Lmin, mH = M - mM - mL;
+                DieValueT L = std::min(A.front(), B.front()) - 1, H = std::max(A.back(), B.back()) + 1, T = (DieValueT)(t + FLT_EPSILON);
+                for (DieValueT T_rounded = T; T_rounded <= T + 1; T_rounded++) // (t + FLT_EPSILON) rounded down and up
+                {
+                    std::vector<DieValueT> C;
+                    DiceUtil::append(C, L, mL);
+                    DiceUtil::append(C, T_rounded, mM);
+                    DiceUtil::append(C, H, mH);
+                    Die die_j(C);
+                    if (die_i.probability_to_beat(die_j) > 0.5 && die_j.probability_to_beat(die_k) > 0.5)
+                        return die_j;
+                }
+            }
+        }
+        return Die();
+    }
+
+    // Run a unit test for the 3-level insertion, i.e. check that the arithmetic search returns the same die as building and comparing all candidate dice
+    // for random pairs of dice, including pairs without a die between them
+    bool three_level_insertion_test(DiceLogger& logger, int num_tests)
+    {
+        std::mt19937 random_generator(23);
+        std::uniform_int_distribution<int> num_sides_distribution(2, 12);
+        std::uniform_int_distribution<DieValueT> value_distribution(1, 20);
+        size_t num_found = 0, num_not_found = 0;
+        for (int test_cnt = 0; test_cnt < num_tests; test_cnt++)
+        {
+            std::vector<DieValueT> A(num_sides_distribution(random_generator)), B(A.size());
+            for (size_t n = 0; n < A.size(); n++)
+            {
+                A[n] = value_distribution(random_generator);
+                B[n] = value_distribution(random_generator);
+            }
+            Die die_i(A), die_k(B); // P(die_i > die_k) <= 0.5 for about half of all pairs, i.e. no die exists
+            Die die_j = DiceGenerator::find_die_between_two_others_3_level_insertion(die_i, die_k);
+            Die expected_die_j = find_die_between_two_others_by_candidate_dice(die_i, die_k);
+            if (die_j.values() != expected_die_j.values())
+            {
+                logger.cerr() << "## ERROR three_level_insertion_test: die (" << die_j.print() << " ) found between (" << die_i.print() << " ) and (" << die_k.print()
+                    << " ), expected (" << expected_die_j.print() << " )" << std::endl << std::endl;
+                return false;
+            }
+            num_found += (die_j.num_values() == die_i.num_values()) ? 1 : 0;
+            num_not_found += (die_j.num_values() == die_i.num_values()) ? 0 : 1;
+        }
+        if (num_found == 0 || num_not_found == 0)
+        {
+            logger.cerr() << "## ERROR three_level_insertion_test: " << num_found << " dice found and " << num_not_found << " pairs without a die, expected both" << std::endl << std::endl;
+            return false;
+        }
+        logger.cout() << "Unittest passed: search by 3-level insertion identical to the search by candidate dice for " << num_found << " pairs with and " << num_not_found << " pairs without a die between them" << std::endl << std::endl;
+        return true;
+    }
+
+    // Run a unit test for the adaptive die search, i.e. check that ADAPTIVE finds a die for all random pairs of dice, for which 3-level insertion finds a die,
+    // and that the statistics count all simple searches, fallbacks and sampled 3-level insertions
+    bool adaptive_search_test(DiceLogger& logger, int num_tests)
+    {
+        std::mt19937 random_generator(17);
+        std::uniform_int_distribution<int> num_sides_distribution(3, 24);
+        std::uniform_int_distribution<DieValueT> value_distribution(1, 40);
+        DiceGenerator::FindDieStatistics statistics;
+        size_t num_three_level_found = 0;
+        bool success = true;
+        for (int test_cnt = 0; test_cnt < num_tests && success; test_cnt++)
+        {
+            std::vector<DieValueT> A(num_sides_distribution(random_generator)), B(A.size());
+            for (size_t n = 0; n < A.size(); n++)
+            {
+                A[n] = value_distribution(random_generator);
+                B[n] = value_distribution(random_generator);
+            }
+            Die die_i(A), die_k(B);
+            if (die_i.probability_to_beat(die_k) <= 0.5)
+                continue;
+            Die die_j = DiceGenerator::find_die_between_two_others(die_i, die_k, DiceGenerator::FindDieStrategy::THREE_LEVEL_INSERTION);
+            Die adaptive_die_j = DiceGenerator::find_die_between_two_others(die_i, die_k, DiceGenerator::FindDieStrategy::ADAPTIVE, &statistics);
+            bool found = (die_j.num_values() == die_i.num_values()), adaptive_found = (adaptive_die_j.num_values() == die_i.num_values());
+            num_three_level_found += found ? 1 : 0;
+            success = (!found || adaptive_found) && (!adaptive_found || (die_i.probability_to_beat(adaptive_die_j) > 0.5 && adaptive_die_j.probability_to_beat(die_k) > 0.5));
+        }
+        success = success && statistics.num_found >= num_three_level_found && statistics.num_simple_searches == statistics.num_searches
+            && statistics.num_three_level_searches == statistics.num_simple_searches - statistics.num_simple_found
+            && statistics.num_sampled_three_level_searches == 0 && !statistics.has_saved_seconds(); // sampling is off by default
+        if (!success)
+        {
+            logger.cerr() << "## ERROR adaptive_search_test: adaptive die search misses a die found by 3-level insertion: " << statistics.print() << std::endl;
+            return false;
+        }
+        logger.cout() << "Unittest passed: adaptive die search " << statistics.print() << std::endl << std::endl;
+        return true;
+    }
+
+    // Run a unit test for the statistics of the adaptive die search, i.e. check the fallback accounting on a pair of dice, where the simple search
+    // is known to fail and 3-level insertion finds a die, and the optional sampling of 3-level insertions on a pair, where the simple search succeeds
+    bool adaptive_statistics_test(DiceLogger& logger)
+    {
+        Die fallback_die_i({ 2, 4, 8 }), fallback_die_k({ 1, 4, 6 }); // no die found by the simple search, but (0, 7, 7) by 3-level insertion
+        DiceGenerator::FindDieStatistics fallback_statistics;
+        Die fallback_die_j = DiceGenerator::find_die_between_two_others(fallback_die_i, fallback_die_k, DiceGenerator::FindDieStrategy::ADAPTIVE, &fallback_statistics);
+        bool success = fallback_die_j.num_values() == fallback_die_i.num_values() && fallback_statistics.num_searches == 1 && fallback_statistics.num_found == 1
+            && fallback_statistics.num_simple_searches == 1 && fallback_statistics.num_simple_found == 0 && fallback_statistics.num_three_level_searches == 1
+            && fallback_statistics.fallback_rate() == 1.0 && !fallback_statistics.has_saved_seconds() && fallback_statistics.print().find("n/a") != std::string::npos;
+        Die simple_die_i({ 1, 5, 9 }), simple_die_k({ 2, 3, 7 }); // (3, 4, 8) found by the simple search
+        DiceGenerator::FindDieStatistics sampled_statistics;
+        sampled_statistics.three_level_sample_interval = 2; // 3-level insertion timed on the 1st and 3rd die found by the simple search
+        for (int search_cnt = 0; search_cnt < 3; search_cnt++)
+            success = DiceGenerator::find_die_between_two_others(simple_die_i, simple_die_k, DiceGenerator::FindDieStrategy::ADAPTIVE, &sampled_statistics).num_values() == simple_die_i.num_values() && success;
+        success = success && sampled_statistics.num_simple_found == 3 && sampled_statistics.num_three_level_searches == 0 && sampled_statistics.fallback_rate() == 0.0
+            && sampled_statistics.num_sampled_three_level_searches == 2 && sampled_statistics.has_saved_seconds();
+        if (!success)
+        {
+            logger.cerr() << "## ERROR adaptive_statistics_test: " << fallback_statistics.print() << ", sampled: " << sampled_statistics.print() << std::endl;
+            return false;
+        }
+        logger.cout() << "Unittest passed: adaptive die search statistics count fallbacks and sampled 3-level insertions" << std::endl << std::endl;
+        return true;
+    }
+
     // Run basic unit tests
     bool run(DiceLogger& logger)
     {
         bool success = true;
+        success = count_beats_test(logger) && success;
+        success = multi_die_test(logger) && success;
+        success = graph_test(logger) && success;
+        success = cycle_search_engine_test(logger) && success;
+        success = cycle_search_visitor_test(logger) && success;
+        success = cycle_dedup_test(logger) && success;
+        success = cycle_count_test(logger) && success;
+        success = robust_path_test(logger) && success;
+        success = simple_cycle_test(logger) && success;
+        success = search_limits_test(logger) && success;
+        success = symmetric_search_test(logger) && success;
+        success = incremental_beat_matrix_test(logger) && success;
+        success = dice_cycle_test(logger) && success;
+        success = value_gaps_test(logger) && success;
+        success = three_level_insertion_test(logger) && success;
+        success = adaptive_search_test(logger) && success;
+        success = adaptive_statistics_test(logger) && success;
         success = insertion_test({ 2, 19, 22, 23, 29, 30 }, { 9, 16, 16, 19, 31, 38 }, logger) && success;
         success = insertion_test({ 6, 11, 16, 21, 26, 31 }, { 5, 10, 15, 20, 25, 36 }, logger) && success;
         success = insertion_test({ 5, 10, 15, 20, 25, 36 }, { 4,  9, 14, 19, 30, 35 }, logger) && success;
@@ -12,4 +12,64 @@ namespace DiceUnittest
     // Run a unit test for 3-level insertion algorithm
     bool insertion_test(const std::vector<DieValueT>& A, const std::vector<DieValueT>& B, DiceLogger& logger, int max_iterations = 2);
 
+    // Run a unit test for beat counting, i.e. check that all supported SIMD dispatch paths count identical wins and losses
+    bool count_beats_test(DiceLogger& logger, int num_tests = 1000);
+
+    // Run a unit test for multi dice, i.e. check that the histogram of dice sums counts identical wins and losses as all combinations of dice sums
+    bool multi_die_test(DiceLogger& logger);
+
+    // Run a unit test for the bit matrix and strongly connected components, i.e. check Tarjan's algorithm against the reachability of random graphs,
+    // check the simple cycles of small random graphs against an exhaustive search, and check the Hamiltonian cycles in random tournaments
+    bool graph_test(DiceLogger& logger, int num_tests = 100);
+
+    // Run a unit test for the closed cycle search engines, i.e. check that all cycle search engines find identical intransitive paths in random dice sets
+    bool cycle_search_engine_test(DiceLogger& logger, int num_tests = 100);
+
+    // Run a unit test for the streaming path search, i.e. check that visit_intransitive_paths streams the paths found by the cycle search
+    bool cycle_search_visitor_test(DiceLogger& logger, int num_tests = 100);
+
+    // Run a unit test for the deduplicating path list, i.e. check that rotated and mirrored paths are dropped
+    bool cycle_dedup_test(DiceLogger& logger, int num_tests = 100);
+
+    // Run a unit test for counting intransitive paths, i.e. check that the number of paths and a sampled witness path match
+    bool cycle_count_test(DiceLogger& logger, int num_tests = 100);
+
+    // Run a unit test for the most robust intransitive path, i.e. check its bottleneck probability against all paths
+    bool robust_path_test(DiceLogger& logger, int num_tests = 100);
+
+    // Run a unit test for the simple cycle enumeration, i.e. check that the simple cycles through all dice are the intransitive paths
+    bool simple_cycle_test(DiceLogger& logger, int num_tests = 100);
+
+    // Run a unit test for the limits of the path search, i.e. check that a search stops at the deadline resp. the memory budget,
+    // and that an incomplete result is not cached
+    bool search_limits_test(DiceLogger& logger);
+
+    // Run a unit test for the symmetry-aware path search, i.e. check that SYMMETRIC_BACKTRACKING and the expanded path orbits
+    // give the same paths as BACKTRACKING for Munnoz-Perera dice
+    bool symmetric_search_test(DiceLogger& logger);
+
+    // Run a unit test for the incremental beat matrix, i.e. check that inserting, appending and removing dice updates the win counts
+    // to the counts computed from scratch
+    bool incremental_beat_matrix_test(DiceLogger& logger);
+
+    // Run a unit test for the growable dice cycle, i.e. check that dice inserted in place into small chunks give the same intransitive cycle
+    // as dice inserted into a single chunk
+    bool dice_cycle_test(DiceLogger& logger);
+
+    // Run a unit test for the failure-aware extension, i.e. check that opening gaps between the values of failed edges keeps all win counts,
+    // and that the failed edges of Munnoz-Perera dice can be extended after opening the gaps
+    bool value_gaps_test(DiceLogger& logger);
+
+    // Run a unit test for the 3-level insertion, i.e. check that the arithmetic search returns the same die as building and comparing all candidate dice
+    // for random pairs of dice, including pairs without a die between them
+    bool three_level_insertion_test(DiceLogger& logger, int num_tests = 2000);
+
+    // Run a unit test for the adaptive die search, i.e. check that ADAPTIVE finds a die for all random pairs of dice, for which 3-level insertion finds a die,
+    // and that the statistics count all simple searches and fallbacks
+    bool adaptive_search_test(DiceLogger& logger, int num_tests = 1000);
+
+    // Run a unit test for the statistics of the adaptive die search, i.e. check the fallback accounting on a pair of dice, where the simple search
+    // is known to fail and 3-level insertion finds a die, and the optional sampling of 3-level insertions on a pair, where the simple search succeeds
+    bool adaptive_statistics_test(DiceLogger& logger);
+
 } // namespace DiceUnittest
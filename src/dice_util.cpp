@@ -1,5 +1,7 @@
 // Utility functions for dice
+#include <algorithm>
 #include <assert.h>
+#include "dice_simd.h"
 #include "dice_util.h"
 
 namespace DiceUtil
@@ -24,15 +26,67 @@ namespace DiceUtil
           X.push_back(x);
   }
 
+  // Counts the number of pairs (a, b) with a > b and a < b for all a in A and b in B, i.e. returns the number of A-beats-B and B-beats-A outcomes.
+  // A and B must be sorted in ascending order. Both vectors are merged once with the scalar two pointer kernel (see DiceSimd::count_beats_scalar).
+  template <typename A_type, typename B_type> std::array<size_t, 2> count_beats_sorted(const std::vector<A_type>& A, const std::vector<B_type>& B)
+  {
+      assert(std::is_sorted(A.begin(), A.end()) && std::is_sorted(B.begin(), B.end()));
+      return DiceSimd::count_beats_scalar(A.data(), A.size(), B.data(), B.size());
+  }
+
+  // Counts the number of pairs (a, b) with a > b and a < b for sorted int64 vectors using the AVX2 or AVX-512 kernel detected at startup (see DiceSimd).
+  template <> std::array<size_t, 2> count_beats_sorted<int64_t, int64_t>(const std::vector<int64_t>& A, const std::vector<int64_t>& B)
+  {
+      return DiceSimd::count_beats_sorted(A.data(), A.size(), B.data(), B.size());
+  }
+
+  // Counts the number of pairs (a, b) with a > b and a < b for all a in A and b in B, where A and B are histograms, i.e. lists of (value, multiplicity) pairs.
+  // A and B must be sorted by value in ascending order. Both histograms are merged once with two pointers, each pair of values is weighted by the product of their multiplicities.
+  template <typename T> std::array<size_t, 2> count_beats_weighted(const std::vector<std::pair<T, size_t>>& A, const std::vector<std::pair<T, size_t>>& B)
+  {
+      std::array<size_t, 2> beat_cnt = { 0, 0 };
+      size_t A_total = 0, B_total = 0;
+      for (size_t i = 0; i < A.size(); i++)
+          A_total += A[i].second;
+      for (size_t j = 0; j < B.size(); j++)
+          B_total += B[j].second;
+      assert(A_total <= MAX_NUM_VALUES && B_total <= MAX_NUM_VALUES); // A_total * B_total outcomes must not overflow
+      size_t num_less = 0, num_less_equal = 0; // merge pointers into B with B[j].first < A[i].first resp. B[j].first <= A[i].first
+      size_t cnt_less = 0, cnt_less_equal = 0; // sum of multiplicities of all values in B[0..num_less) resp. B[0..num_less_equal)
+      for (size_t i = 0; i < A.size(); i++)
+      {
+          while (num_less < B.size() && B[num_less].first < A[i].first)
+              cnt_less += B[num_less++].second;
+          if (num_less_equal < num_less)
+          {
+              num_less_equal = num_less;
+              cnt_less_equal = cnt_less;
+          }
+          while (num_less_equal < B.size() && B[num_less_equal].first <= A[i].first)
+              cnt_less_equal += B[num_less_equal++].second;
+          beat_cnt[0] += A[i].second * cnt_less;
+          beat_cnt[1] += A[i].second * (B_total - cnt_less_equal);
+      }
+      return beat_cnt;
+  }
+
   // Returns P(A>B)
   template <typename A_type, typename B_type> double probability_to_beat(const std::vector<A_type>& A, const std::vector<B_type>& B)
   {
-      size_t beat_cnt = 0;
-      for (size_t i = 0; i < A.size(); i++)
-          for (size_t j = 0; j < B.size(); j++)
-              if (A[i] > B[j])
-                  beat_cnt++;
-      return (double)beat_cnt / (double)(A.size() * B.size());
+      std::array<size_t, 2> beat_cnt;
+      if (std::is_sorted(A.begin(), A.end()) && std::is_sorted(B.begin(), B.end()))
+      {
+          beat_cnt = count_beats_sorted(A, B);
+      }
+      else
+      {
+          std::vector<A_type> A_sorted(A);
+          std::vector<B_type> B_sorted(B);
+          std::sort(A_sorted.begin(), A_sorted.end());
+          std::sort(B_sorted.begin(), B_sorted.end());
+          beat_cnt = count_beats_sorted(A_sorted, B_sorted);
+      }
+      return (double)beat_cnt[0] / (double)(A.size() * B.size());
   }
 
   // Returns true, if a given number is a prime
@@ -93,6 +147,46 @@ namespace DiceUtil
     }
   }
 
+  // Returns the histogram of a vector, i.e. a list of (value, multiplicity) pairs sorted by value in ascending order
+  template <typename T> std::vector<std::pair<T, size_t>> histogram(const std::vector<T>& X)
+  {
+    std::vector<T> X_sorted(X);
+    std::sort(X_sorted.begin(), X_sorted.end());
+    std::vector<std::pair<T, size_t>> hist;
+    for (size_t n = 0; n < X_sorted.size(); n++)
+    {
+      if (hist.empty() || hist.back().first != X_sorted[n])
+        hist.push_back(std::pair<T, size_t>(X_sorted[n], 0));
+      hist.back().second++;
+    }
+    return hist;
+  }
+
+  // Returns the histogram of all dice sums, i.e. the distribution of the sum of rolling all dice as a list of (sum, multiplicity) pairs sorted by sum in ascending order.
+  // The histogram is built by iterative convolution of the single dice histograms, without generating all combinations of dice sums.
+  template <typename T> std::vector<std::pair<T, size_t>> sum_histogram(const std::vector<std::vector<T>>& dice)
+  {
+    std::vector<std::pair<T, size_t>> sum_hist = { std::pair<T, size_t>(0, 1) }; // sum of zero dice
+    for (size_t die_index = 0; die_index < dice.size(); die_index++)
+    {
+      std::vector<std::pair<T, size_t>> die_hist = histogram(dice[die_index]);
+      std::vector<std::pair<T, size_t>> sums;
+      sums.reserve(sum_hist.size() * die_hist.size());
+      for (size_t i = 0; i < sum_hist.size(); i++)
+        for (size_t j = 0; j < die_hist.size(); j++)
+          sums.push_back(std::pair<T, size_t>(sum_hist[i].first + die_hist[j].first, sum_hist[i].second * die_hist[j].second));
+      std::sort(sums.begin(), sums.end(), [](const std::pair<T, size_t>& a, const std::pair<T, size_t>& b) { return a.first < b.first; });
+      sum_hist.clear();
+      for (size_t n = 0; n < sums.size(); n++)
+      {
+        if (sum_hist.empty() || sum_hist.back().first != sums[n].first)
+          sum_hist.push_back(std::pair<T, size_t>(sums[n].first, 0));
+        sum_hist.back().second += sums[n].second;
+      }
+    }
+    return sum_hist;
+  }
+
   // Formats a vector of integers into a string
   template <typename T> std::string print(const std::vector<T>& vec)
   {
@@ -131,12 +225,19 @@ namespace DiceUtil
   template void append(std::vector<int>& X, const int& x, size_t n);
   template void append(std::vector<int64_t>& X, const int64_t& x, size_t n);
   template void append(std::vector<double>& X, const double& x, size_t n);
+  template std::array<size_t, 2> count_beats_sorted<double, double>(const std::vector<double>& A, const std::vector<double>& B);
+  template std::array<size_t, 2> count_beats_sorted<int64_t, double>(const std::vector<int64_t>& A, const std::vector<double>& B);
+  template std::array<size_t, 2> count_beats_sorted<double, int64_t>(const std::vector<double>& A, const std::vector<int64_t>& B);
+  template std::array<size_t, 2> count_beats_weighted<int64_t>(const std::vector<std::pair<int64_t, size_t>>& A, const std::vector<std::pair<int64_t, size_t>>& B);
   template double probability_to_beat<int64_t, int64_t>(const std::vector<int64_t>& A, const std::vector<int64_t>& B);
   template double probability_to_beat<double, double>(const std::vector<double>& A, const std::vector<double>& B);
   template double probability_to_beat<int64_t, double>(const std::vector<int64_t>& A, const std::vector<double>& B);
   template double probability_to_beat<double, int64_t>(const std::vector<double>& A, const std::vector<int64_t>& B);
   template void generate_sums_recursively<int>(const std::vector<std::vector<int>>& dice, size_t die_index, int current_sum, std::vector<int>& results);
   template void generate_sums_recursively<int64_t>(const std::vector<std::vector<int64_t>>& dice, size_t die_index, int64_t current_sum, std::vector<int64_t>& results);
+  template std::vector<std::pair<int, size_t>> histogram<int>(const std::vector<int>& X);
+  template std::vector<std::pair<int64_t, size_t>> histogram<int64_t>(const std::vector<int64_t>& X);
+  template std::vector<std::pair<int64_t, size_t>> sum_histogram<int64_t>(const std::vector<std::vector<int64_t>>& dice);
   template std::string print<int>(const std::vector<int>& vec);
   template std::string print<int64_t>(const std::vector<int64_t>& vec);
   template std::string print<double>(const std::vector<double>& vec);
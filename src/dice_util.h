@@ -1,5 +1,7 @@
 // Utility functions for dice
 #pragma once
+#include <array>
+#include <cstdint>
 #include <iomanip>
 #include <random>
 #include <sstream>
@@ -8,12 +10,26 @@
 
 namespace DiceUtil
 {
+    // Max. number of values of a die resp. of sums of a dice tuple (M^K for K M-sided dice), such that the number of outcomes of rolling two dice fits into size_t
+    constexpr size_t MAX_NUM_VALUES = ((size_t)1 << (4 * sizeof(size_t))) - 1;
+
     // Cumulative distribution function: return the probability P(x<t), i.e. sum of all values below or equal threshold t divided by number of elements
     template <typename T> double cdf(const std::vector<T>& X, double t);
 
     // Appends value x n-times to vector X
     template <typename T> void append(std::vector<T>& X, const T& x, size_t n);
       
+    // Counts the number of pairs (a, b) with a > b and a < b for all a in A and b in B, i.e. returns the number of A-beats-B and B-beats-A outcomes.
+    // A and B must be sorted in ascending order. Both vectors are merged once with two pointers in O(|A| + |B|), ties a == b are counted neither as win nor as loss.
+    template <typename A_type, typename B_type> std::array<size_t, 2> count_beats_sorted(const std::vector<A_type>& A, const std::vector<B_type>& B);
+
+    // Counts the number of pairs (a, b) with a > b and a < b for sorted int64 vectors using the AVX2 or AVX-512 kernel detected at startup (see DiceSimd).
+    template <> std::array<size_t, 2> count_beats_sorted<int64_t, int64_t>(const std::vector<int64_t>& A, const std::vector<int64_t>& B);
+
+    // Counts the number of pairs (a, b) with a > b and a < b for all a in A and b in B, where A and B are histograms, i.e. lists of (value, multiplicity) pairs.
+    // A and B must be sorted by value in ascending order. Both histograms are merged once with two pointers, each pair of values is weighted by the product of their multiplicities.
+    template <typename T> std::array<size_t, 2> count_beats_weighted(const std::vector<std::pair<T, size_t>>& A, const std::vector<std::pair<T, size_t>>& B);
+
     // Returns P(A>B)
     template <typename A_type, typename B_type> double probability_to_beat(const std::vector<A_type>& A, const std::vector<B_type>& B);
 
@@ -32,6 +48,13 @@ namespace DiceUtil
     // Generates all combinations of dice sums recursively
     template <typename T> void generate_sums_recursively(const std::vector<std::vector<T>>& dice, size_t die_index, T current_sum, std::vector<T>& results);
 
+    // Returns the histogram of a vector, i.e. a list of (value, multiplicity) pairs sorted by value in ascending order
+    template <typename T> std::vector<std::pair<T, size_t>> histogram(const std::vector<T>& X);
+
+    // Returns the histogram of all dice sums, i.e. the distribution of the sum of rolling all dice as a list of (sum, multiplicity) pairs sorted by sum in ascending order.
+    // The histogram is built by iterative convolution of the single dice histograms, without generating all combinations of dice sums.
+    template <typename T> std::vector<std::pair<T, size_t>> sum_histogram(const std::vector<std::vector<T>>& dice);
+
     // Formats a vector of integers into a string
     template <typename T> std::string print(const std::vector<T>& vec);
 
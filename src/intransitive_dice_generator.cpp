@@ -14,6 +14,9 @@ std::string print_help(void)
     str << "By default (i.e.no command line options given), intransitive_dice_generator creates and prints examples of intransitive dice with different cycle lengths." << std::endl;
     str << "To create a chain of N intransitive M-sided dice with N>=M, call intransitive_dice_generator with arguments -N=<int> -M=<int>." << std::endl;
     str << "Example: \"intransitive_dice_generator -N=12 -M=6\" creates 12 intransitive six-sided dice." << std::endl;
+    str << "Option -adaptive tries the simple die search first and 3-level insertion only if the simple search fails (default: -3-level, alternative: -simple)." << std::endl;
+    str << "Option -adaptive-sample=<int> additionally times 3-level insertion on every n-th die found by the simple search to estimate the time saved (costs extra searches)." << std::endl;
+    str << "Option -retry-failed-edges retries only the dice pairs without a new die after opening gaps between their values, instead of doubling all values." << std::endl;
     str << "All messages are logged in file intransitive_dice_generator.log." << std::endl;
     return str.str();
 }
@@ -46,7 +49,7 @@ template <typename DiceSetType> void print_intransitive_paths(DiceSetType& dice_
     else
         logger.cout() << dice_set.name() << " is NOT intransitive and has " << intransitive_paths.size() << " intransitive paths" << std::endl;
     int path_cnt = 0;
-    for (std::list<DicePath>::const_iterator path_iter = intransitive_paths.cbegin(); path_iter != intransitive_paths.cend() && path_cnt < max_paths_to_print; path_iter++, path_cnt++)
+    for (DicePathList::const_iterator path_iter = intransitive_paths.cbegin(); path_iter != intransitive_paths.cend() && path_cnt < max_paths_to_print; path_iter++, path_cnt++)
         logger.cout() << dice_set.name() << ", " << (path_cnt + 1) << ". intransitive path probabilities: " << dice_set.print_intransitive_path_probabilities(*path_iter) << path_iter->print_bonus(", ") << std::endl;
     if (path_cnt < intransitive_paths.size())
         logger.cout() << "..." << std::endl;
@@ -75,14 +78,23 @@ int main(int argc, char** argv)
       strategy = DiceGenerator::FindDieStrategy::SIMPLE;
     else if (DiceUtil::has_cli_arg(argc, argv, "-3-level"))
       strategy = DiceGenerator::FindDieStrategy::THREE_LEVEL_INSERTION;
-    else if (N > 10000) // 3 level insertion can become timeconsuming for intransitive cycles of more than 10000 dice. In this case, a simple search by find_die_between_two_others_simple
-      strategy = DiceGenerator::FindDieStrategy::SIMPLE; // can be an alternative (simple and fast for many dice, but may fail, counter examples exist).
+    else if (DiceUtil::has_cli_arg(argc, argv, "-adaptive"))
+      strategy = DiceGenerator::FindDieStrategy::ADAPTIVE;
+    DiceGenerator::RetryStrategy retry_strategy = DiceGenerator::RetryStrategy::DOUBLE_ALL_VALUES; // retry by doubling all values, if no new dice are found
+    if (DiceUtil::has_cli_arg(argc, argv, "-retry-failed-edges"))
+      retry_strategy = DiceGenerator::RetryStrategy::OPEN_GAPS_AT_FAILED_EDGES;
     // Create N intransitive M-sided dice for given N and M by extending N N-sided Munnoz-Perera dice
     DiceSet  mp_dice = DiceGenerator::munnoz_perera(M);
     DicePath mp_dice_path = DiceGenerator::munnoz_perera_path(M);
     DiceSet mp_extended("Extended Munnoz Perera " + std::to_string(M) + "-sided dice", {});
     DicePath mp_extended_path;
-    bool success = DiceGenerator::extend_set_by_intransitive_dice_insertion(mp_dice, mp_dice_path, N, mp_extended, mp_extended_path, strategy);
+    DiceGenerator::FindDieStatistics statistics;
+    int three_level_sample_interval = 0;
+    if (DiceUtil::has_cli_arg(argc, argv, "-adaptive-sample=", three_level_sample_interval) && three_level_sample_interval > 0)
+      statistics.three_level_sample_interval = (size_t)three_level_sample_interval;
+    bool success = DiceGenerator::extend_set_by_intransitive_dice_insertion(mp_dice, mp_dice_path, N, mp_extended, mp_extended_path, strategy, 2, 0, 0, retry_strategy, &statistics);
+    if (strategy == DiceGenerator::FindDieStrategy::ADAPTIVE)
+      logger.cout() << "Adaptive die search: " << statistics.print() << std::endl;
     if (success)
       logger.cout() << mp_extended.print_path_probabilities_x(mp_extended_path, true) << std::endl;
     else
@@ -131,7 +143,7 @@ int main(int argc, char** argv)
   // if a N N-sided Munnoz-Perera dice with N = 6*K are partitioned into N tuples of 6-sided dice, where each tuple has K 6-sided dice and the sum of the 6-sided dice in the tuple counts.
   // I haven't found a mathematical proof that this relation remains under partitioning. But we can test it by simulation: We just partition N N-sided Munnoz-Perera dice with N=6*K
   // into N dice tuples (where each tuple has K 6-sided dice).
-  for (int N = 12, M = 6; N <= 30; N+=M) // for (int N = 12, M = 6; N <= 30; N+=M) // N = [12, 18, 24, 30] = number of dice tupel, M = 6 = number of sides of a die. Tested up to N = 42. Note that the calculation for N > 30 becomes very time consuming...
+  for (int N = 12, M = 6; N <= 30; N+=M) // for (int N = 12, M = 6; N <= 30; N+=M) // N = [12, 18, 24, 30] = number of dice tupel, M = 6 = number of sides of a die. Tested up to N = 42. MultiDie stores the distribution of sums as a histogram, so N > 30 (i.e. K > 5 dice per tuple) remains fast.
   {
     DiceSet dice_set = DiceGenerator::munnoz_perera(N);
     DicePath dice_path = DiceGenerator::munnoz_perera_path(N);
@@ -179,9 +191,7 @@ int main(int argc, char** argv)
   DiceSet oskar_extended("Extended Oskar dice", {});
   DicePath oskar_extended_path;
   size_t max_num_dice = 1000; // Tested with up to 10 million dice - feel free to create intransitive cycles with as many dice as desired.
-  DiceGenerator::FindDieStrategy strategy = DiceGenerator::FindDieStrategy::THREE_LEVEL_INSERTION; // 3 level insertion by find_die_between_two_others_3_level_insertion
-  if (max_num_dice > 10000) // 3 level insertion can become timeconsuming for intransitive cycles of more than 10000 dice. In this case, a simple search by find_die_between_two_others_simple
-    strategy = DiceGenerator::FindDieStrategy::SIMPLE; // can be an alternative (simple and fast for many dice, but may fail, counter examples exist).
+  DiceGenerator::FindDieStrategy strategy = DiceGenerator::FindDieStrategy::THREE_LEVEL_INSERTION; // 3 level insertion by find_die_between_two_others_3_level_insertion, searched in parallel for all edges of the path
   bool success = (DiceGenerator::extend_set_by_intransitive_dice_insertion(oskar_dice, oskar_dice_path, max_num_dice, oskar_extended, oskar_extended_path, strategy) && oskar_extended_path.size() >= max_num_dice);
       logger.cout() << oskar_extended.print_path_probabilities_x(oskar_extended_path, true) << std::endl;
   if (!success)